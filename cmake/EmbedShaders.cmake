@@ -0,0 +1,31 @@
+# Gera um cabeçalho C++ com o código de todos os shaders de SHADER_DIR, para que o jogo
+# não precise ler arquivos ao iniciar.
+# Uso: cmake -DSHADER_DIR=<res/shaders> -DOUTPUT=<EmbeddedShaders.h> -P EmbedShaders.cmake
+
+file(GLOB SHADER_FILES RELATIVE "${SHADER_DIR}" "${SHADER_DIR}/*.vert" "${SHADER_DIR}/*.frag")
+list(SORT SHADER_FILES)
+
+set(CONTENT "// Arquivo gerado por cmake/EmbedShaders.cmake a partir de res/shaders. Não edite.\n")
+string(APPEND CONTENT "#ifndef EMBEDDED_SHADERS_H\n#define EMBEDDED_SHADERS_H\n\n")
+string(APPEND CONTENT "#include <cstddef>\n\n")
+string(APPEND CONTENT "// Nome do arquivo (ex: \"snakeColor.frag\") e código-fonte de um shader.\n")
+string(APPEND CONTENT "struct EmbeddedShader {\n    const char* name;\n    const char* source;\n};\n\n")
+string(APPEND CONTENT "constexpr EmbeddedShader EMBEDDED_SHADERS[] = {\n")
+foreach(SHADER_FILE ${SHADER_FILES})
+    file(READ "${SHADER_DIR}/${SHADER_FILE}" SOURCE)
+    # Os finais de linha do Windows (CRLF) não fazem diferença para o GLSL.
+    string(REPLACE "\r\n" "\n" SOURCE "${SOURCE}")
+    # Literal de string bruta: o código entra como está, sem escapar aspas nem barras.
+    string(APPEND CONTENT "    {\"${SHADER_FILE}\", R\"GLSL(${SOURCE})GLSL\"},\n")
+endforeach()
+string(APPEND CONTENT "};\n\n")
+string(APPEND CONTENT "constexpr size_t EMBEDDED_SHADER_COUNT = sizeof(EMBEDDED_SHADERS) / sizeof(EMBEDDED_SHADERS[0]);\n\n")
+string(APPEND CONTENT "#endif\n")
+
+# Só regrava o arquivo se o conteúdo mudou, para não recompilar à toa.
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" PREVIOUS)
+endif()
+if(NOT "${PREVIOUS}" STREQUAL "${CONTENT}")
+    file(WRITE "${OUTPUT}" "${CONTENT}")
+endif()
@@ -0,0 +1,75 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef BATCH_SIM_H
+#define BATCH_SIM_H
+
+// Inclui vetores da STL, os tipos inteiros de tamanho fixo e as regras do jogo.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Simulation.h"
+
+// O BatchSim avança N partidas independentes ao mesmo tempo, todas no mesmo grid.
+// Os dados usados a cada passo (cabeças, direções, tamanhos e comidas) ficam em
+// "estrutura de arrays" (um vetor por campo, um elemento por partida), para que os
+// laços de movimento, limites e comida sejam vetorizados (SIMD) pelo compilador.
+// Os corpos continuam em objetos Snake, que cuidam do buffer circular, do mapa de
+// ocupação e das células livres. Uma partida que termina é reiniciada no lugar,
+// como faz 'resetGame', e o passo seguinte já começa na partida nova.
+class BatchSim {
+public:
+    // Construtor: cria 'numEnvs' partidas em grids de 'gridWidth' x 'gridHeight'.
+    // Cada partida tem seu próprio gerador, com a semente 'seed' e a sequência (stream)
+    // igual ao seu índice, então o lote inteiro é reproduzível.
+    BatchSim(size_t numEnvs, int gridWidth, int gridHeight, uint64_t seed);
+
+    // Avança todas as partidas em um passo. 'actions' deve ter uma ação por partida.
+    void step(const Action* actions);
+
+    // Número de partidas simuladas.
+    size_t size() const { return snakes.size(); }
+
+    // --- RESULTADOS DO ÚLTIMO PASSO (UM ELEMENTO POR PARTIDA) ---
+    // 1 se a partida comeu a comida no último passo.
+    const uint8_t* getAteFood() const { return ateFood.data(); }
+    // 1 se a partida terminou (derrota ou vitória) e foi reiniciada no último passo.
+    const uint8_t* getDone() const { return done.data(); }
+    // Pontuação com que a partida terminou (válido quando 'done' é 1).
+    const int32_t* getFinalScore() const { return finalScore.data(); }
+
+    // --- ESTADO ATUAL (UM ELEMENTO POR PARTIDA) ---
+    const int32_t* getHeadX() const { return headX.data(); }
+    const int32_t* getHeadY() const { return headY.data(); }
+    const int32_t* getFoodX() const { return foodX.data(); }
+    const int32_t* getFoodY() const { return foodY.data(); }
+    const int32_t* getLength() const { return length.data(); }
+    // Direção atual, com os mesmos valores de Direction (UP=0, DOWN=1, LEFT=2, RIGHT=3).
+    const int32_t* getDirection() const { return direction.data(); }
+    // Corpo completo de uma partida.
+    const Snake& getSnake(size_t env) const { return snakes[env]; }
+
+private:
+    // Reinicia a partida 'env' no lugar, sem realocar memória.
+    void resetEnv(size_t env);
+    // Sorteia uma nova comida para a partida 'env'.
+    void placeFood(size_t env);
+
+    const int gridWidth;  // Largura do grid (em células).
+    const int gridHeight; // Altura do grid (em células).
+
+    // --- ESTRUTURA DE ARRAYS ---
+    std::vector<int32_t> headX, headY;  // Cabeça de cada partida.
+    std::vector<int32_t> direction;     // Direção atual de cada partida.
+    std::vector<int32_t> length;        // Número de segmentos de cada partida.
+    std::vector<int32_t> foodX, foodY;  // Comida de cada partida.
+    std::vector<uint8_t> ateFood;       // Comeu no último passo.
+    std::vector<uint8_t> outOfBounds;   // Saiu do grid no último passo.
+    std::vector<uint8_t> done;          // Terminou no último passo.
+    std::vector<int32_t> finalScore;    // Pontuação final da partida que terminou.
+
+    // Corpos das cobras (buffer circular, ocupação e células livres).
+    std::vector<Snake> snakes;
+    // Gerador aleatório de cada partida, usado para sortear a comida.
+    std::vector<Random> rngs;
+};
+
+#endif
@@ -0,0 +1,66 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef BOARD_TEXTURE_H
+#define BOARD_TEXTURE_H
+
+// Inclui o cabeçalho do GLAD para as funções do OpenGL.
+#include <glad/glad.h>
+// Inclui vetores da STL e os tipos inteiros de tamanho fixo.
+#include <vector>
+#include <cstdint>
+// Inclui o buffer circular do corpo da cobra e a definição de GridPosition.
+#include "RingBuffer.h"
+#include "GridPosition.h"
+
+// Código de cada célula na textura do tabuleiro.
+enum BoardCell : uint8_t {
+    BOARD_EMPTY = 0,
+    BOARD_BODY = 1,
+    BOARD_HEAD = 2,
+    BOARD_FOOD = 3
+};
+
+// O tabuleiro inteiro como uma textura de um byte por célula (GL_R8UI), para grids
+// enormes em que até os quadrados instanciados seriam demais. O frame é um único
+// triângulo de tela cheia cujo fragment shader lê o código da célula sob cada pixel.
+// Uma cópia na CPU guarda os mesmos códigos; cada passo muda no máximo quatro células
+// (cabeça nova, cabeça antiga, rabo e comida), e só essas são enviadas à GPU.
+// Requer um contexto OpenGL ativo na construção e na destruição.
+class BoardTexture {
+public:
+    // Construtor: cria a textura com as dimensões do grid, toda vazia.
+    BoardTexture(int width, int height);
+    // Destrutor: libera a textura.
+    ~BoardTexture();
+
+    // O objeto é dono de recursos do OpenGL, então não pode ser copiado.
+    BoardTexture(const BoardTexture&) = delete;
+    BoardTexture& operator=(const BoardTexture&) = delete;
+
+    // Refaz o tabuleiro inteiro a partir do corpo e da comida (início ou reinício da partida).
+    // 'hasFood' é falso quando a cobra ocupa o grid inteiro. O envio completo acontece no
+    // próximo 'upload'.
+    void rebuild(const RingBuffer<GridPosition>& body, const GridPosition& food, bool hasFood);
+    // Registra as células alteradas por um movimento que não terminou a partida, já aplicado
+    // a 'body'. 'removedTail' é a célula que o rabo deixou (ignorada se a cobra cresceu).
+    void recordMove(const RingBuffer<GridPosition>& body, const GridPosition& removedTail, bool grew);
+    // Registra a nova posição da comida (a antiga ficou sob a cabeça quando foi comida),
+    // depois dos movimentos. Uma célula já ocupada pela cobra não muda.
+    void placeFood(const GridPosition& food);
+    // Envia para a GPU as células alteradas desde a última chamada.
+    void upload();
+    // Associa a textura à unidade de textura 'unit'.
+    void bind(unsigned int unit) const;
+
+private:
+    // Muda o código de uma célula na cópia da CPU e a marca para envio.
+    void set(const GridPosition& p, BoardCell cell);
+
+    unsigned int texture;              // Textura GL_R8UI com um código por célula.
+    int width;                         // Largura do grid (em células).
+    int height;                        // Altura do grid (em células).
+    std::vector<uint8_t> cells;        // Cópia na CPU dos códigos, linha a linha.
+    std::vector<GridPosition> dirty;   // Células alteradas desde o último envio.
+    bool fullUpload;                   // Verdadeiro quando a textura inteira precisa ser enviada.
+};
+
+#endif
@@ -0,0 +1,121 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef FREE_CELL_SET_H
+#define FREE_CELL_SET_H
+
+// Inclui vetores da STL e os tipos inteiros de tamanho fixo.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+// Inclui a definição de GridPosition.
+#include "GridPosition.h"
+
+// Conjunto denso das células livres do grid.
+// 'cells' guarda os índices das células livres lado a lado, e 'slots' diz em que
+// posição de 'cells' cada célula está. Inserir e remover custam O(1) (a remoção troca
+// o elemento com o último), e sortear uma célula livre uniformemente é só escolher
+// um índice aleatório em 'cells', por mais cheio que o grid esteja.
+class FreeCellSet {
+public:
+    // Construtor: começa com todas as células do grid livres.
+    FreeCellSet(int width, int height)
+        : width(width),
+          cells((size_t)width * (size_t)height),
+          slots((size_t)width * (size_t)height)
+    {
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            cells[i] = (uint32_t)i;
+            slots[i] = (uint32_t)i;
+        }
+        count = cells.size();
+    }
+
+    // Remove uma célula do conjunto (ela passou a ser ocupada).
+    // A célula deve estar presente no conjunto.
+    void remove(const GridPosition& p)
+    {
+        uint32_t cell = index(p);
+        uint32_t slot = slots[cell];
+        // Move a última célula livre para o lugar da removida.
+        uint32_t last = cells[count - 1];
+        cells[slot] = last;
+        slots[last] = slot;
+        // Guarda a célula removida logo após o fim do conjunto.
+        cells[count - 1] = cell;
+        slots[cell] = (uint32_t)(count - 1);
+        --count;
+    }
+
+    // Insere uma célula no conjunto (ela voltou a ficar livre).
+    // A célula não deve estar presente no conjunto.
+    void insert(const GridPosition& p)
+    {
+        uint32_t cell = index(p);
+        uint32_t slot = slots[cell];
+        // Troca a célula com a primeira posição depois do fim e aumenta o conjunto.
+        uint32_t first = cells[count];
+        cells[slot] = first;
+        slots[first] = slot;
+        cells[count] = cell;
+        slots[cell] = (uint32_t)count;
+        ++count;
+    }
+
+    // Retorna a i-ésima célula livre, com i em [0, size()).
+    GridPosition at(size_t i) const
+    {
+        uint32_t cell = cells[i];
+        return {(int)(cell % (uint32_t)width), (int)(cell / (uint32_t)width)};
+    }
+
+    // Índice linear (y * largura + x) da i-ésima célula livre.
+    uint32_t indexAt(size_t i) const { return cells[i]; }
+
+    // Reordena as células livres para que a i-ésima seja 'order[i]'.
+    // 'order' deve conter exatamente as 'size()' células livres atuais, em outra ordem.
+    // Como o sorteio escolhe uma posição do conjunto, a ordem faz parte do estado
+    // determinístico da partida (é restaurada a partir dos keyframes de replay).
+    void reorder(const uint32_t* order, size_t orderCount)
+    {
+        for (size_t i = 0; i < orderCount; ++i)
+        {
+            // Troca a célula desejada com a que está na posição 'i'.
+            uint32_t cell = order[i];
+            uint32_t slot = slots[cell];
+            uint32_t displaced = cells[i];
+            cells[slot] = displaced;
+            slots[displaced] = slot;
+            cells[i] = cell;
+            slots[cell] = (uint32_t)i;
+        }
+    }
+
+    // Volta à ordem do construtor: todas as células livres, em ordem de índice.
+    void resetOrder()
+    {
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            cells[i] = (uint32_t)i;
+            slots[i] = (uint32_t)i;
+        }
+        count = cells.size();
+    }
+
+    // Número de células livres. Zero significa que o grid está cheio.
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    // Converte uma posição (x, y) para o índice linear da célula.
+    uint32_t index(const GridPosition& p) const
+    {
+        return (uint32_t)p.y * (uint32_t)width + (uint32_t)p.x;
+    }
+
+    int width;                   // Largura do grid (em células).
+    std::vector<uint32_t> cells; // Células livres em [0, count); ocupadas depois disso.
+    std::vector<uint32_t> slots; // Posição de cada célula dentro de 'cells'.
+    size_t count;                // Número de células livres.
+};
+
+#endif
@@ -6,14 +6,39 @@
 #include <glad/glad.h>   // Para funções do OpenGL.
 #include <GLFW/glfw3.h>  // Para criar janelas e gerenciar entradas.
 #include <glm/glm.hpp>   // Para operações matemáticas com vetores e matrizes.
-#include "Snake.h"       // Inclui a definição da classe Snake.
+#include "Simulation.h"  // Inclui as regras do jogo (estado, passo da simulação).
 #include "Shader.h"      // Inclui a definição da classe Shader.
+#include "Replay.h"      // Inclui o gravador de replays.
+#include "SegmentBuffer.h" // Inclui a cópia do corpo da cobra na GPU.
+#include "BoardTexture.h"  // Inclui o tabuleiro em textura (grids enormes).
+#include "ShaderSources.h" // Inclui a origem do código dos shaders.
+#include "ShaderWatcher.h" // Inclui o observador de arquivos de shader.
+#include "InputQueue.h"    // Inclui a fila de teclas e o buffer de curvas.
+#include "RenderSnapshot.h" // Inclui as fotografias que a simulação publica para o desenho.
+#include "Instrumentation.h" // Inclui os cronômetros e histogramas de tempo.
+#include "Tracing.h"       // Inclui as marcações do trace das fases.
+#include "GpuTimer.h"      // Inclui as medições de tempo na GPU.
+#include <atomic>
+#include <thread>
 
-// A classe Game é responsável por gerenciar todo o ciclo de vida e estado do jogo.
+// A classe Game é a interface gráfica do jogo: cria a janela, lê o teclado e desenha
+// o estado. As regras em si ficam na biblioteca 'snake_core' (veja Simulation.h).
+// A simulação roda em uma thread própria, no ritmo fixo dos passos, e publica fotografias
+// do estado por um buffer triplo; a thread principal (a do OpenGL) desenha a fotografia
+// mais recente. Nenhuma das duas espera pela outra: uma troca de buffers lenta não atrasa
+// os passos, e um passo lento não atrasa os frames.
 class Game {
 public:
+    // A partir deste número de células, o jogo desenha o tabuleiro como uma textura
+    // (um pixel de textura por célula) em vez de um quadrado por segmento.
+    static const long long BOARD_TEXTURE_MIN_CELLS = 512LL * 512LL;
+
     // Construtor: inicializa o jogo com uma largura e altura de tela específicas.
-    Game(unsigned int width, unsigned int height);
+    // 'gridWidth' e 'gridHeight' são as dimensões do tabuleiro, em células.
+    // 'seed' é a semente do gerador aleatório da partida (a mesma semente repete as comidas).
+    // Se 'replayPath' não for nulo, a sessão é gravada nesse arquivo de replay.
+    Game(unsigned int width, unsigned int height, int gridWidth, int gridHeight,
+         uint64_t seed, const char* replayPath = nullptr);
     // Destrutor: libera os recursos alocados pelo jogo.
     ~Game();
 
@@ -22,45 +47,94 @@ public:
 
 private:
     // --- ESTADO DO JOGO ---
-    Snake snake;                          // Objeto que representa a cobra.
-    GridPosition food;                    // Posição da comida no grid.
+    // As dimensões vêm antes do estado porque os membros são inicializados na ordem
+    // em que são declarados, e o estado usa o tamanho do grid no seu construtor.
     const unsigned int screenWidth;       // Largura da janela em pixels.
     const unsigned int screenHeight;      // Altura da janela em pixels.
     const int gridWidth;                  // Largura do grid do jogo (em unidades).
     const int gridHeight;                 // Altura do grid do jogo (em unidades).
+    GameState state;                      // Estado da partida. Só a thread da simulação o usa.
+    double tickInterval;                  // Intervalo (em segundos) entre dois passos.
+
+    // --- THREAD DA SIMULAÇÃO ---
+    // As fotografias vêm antes do publicador, que guarda uma referência a elas.
+    TripleBuffer<RenderSnapshot> snapshots; // Fotografias da simulação para o desenho.
+    SnapshotPublisher publisher;          // Lado da simulação das fotografias.
+    std::thread simulationThread;         // Thread que executa 'simulationLoop'.
+    std::atomic<bool> simulationRunning;  // Falso pede que a thread da simulação termine.
+
+    // --- ESTADO DO DESENHO ---
+    // Cópia do corpo mantida pela thread principal, atualizada pelos movimentos das fotografias.
+    RingBuffer<GridPosition> renderBody;
+    GridPosition renderFood;              // Comida da última fotografia aplicada.
+    uint64_t renderTick;                  // Passo da última fotografia aplicada.
+
+    // --- ENTRADA ---
+    // O callback de teclado empilha cada seta pressionada, com o instante, em 'inputEvents';
+    // a cada passo, 'update' valida os eventos em 'turns' e aplica uma curva.
+    SpscQueue<InputEvent, 64> inputEvents; // Teclas ainda não lidas pela simulação.
+    TurnBuffer turns;                     // Curvas aceitas, uma aplicada por passo.
+    InputLatencyStats inputLatency;       // Latência entre a tecla e o passo que a aplicou.
+    std::atomic<uint64_t> droppedInputs;  // Teclas perdidas com a fila de eventos cheia.
+
+    // --- REPLAY ---
+    ReplayWriter* replay;                 // Gravador do replay da sessão (nulo se não estiver gravando).
 
     // --- JANELA (GLFW) ---
     GLFWwindow* window;                   // Ponteiro para a janela criada pelo GLFW.
 
     // --- SHADER ---
-    Shader* shader;                       // Ponteiro para o objeto de shader que desenha tudo na tela.
+    Shader* segmentShader;                // Shader que desenha a cobra e a comida lendo 'segments'.
+    Shader* gridShader;                   // Shader que calcula as linhas do grid por pixel.
+    ShaderWatcher shaderWatcher;          // Observa SNAKE_SHADER_DIR para recarregar os shaders.
 
     // --- OBJETOS OPENGL ---
     unsigned int VAO, VBO;                // VAO/VBO para os quadrados (corpo da cobra e comida).
-    unsigned int gridVAO, gridVBO;        // VAO/VBO para as linhas do grid.
-    unsigned int projectionLoc;           // Localização do uniform 'projection' no shader.
-    unsigned int modelLoc;                // Localização do uniform 'model' no shader.
-    unsigned int colorLoc;                // Localização do uniform 'objectColor' no shader.
+    SegmentBuffer* segments;              // Corpo da cobra na GPU, atualizado só nas posições que mudam.
+    BoardTexture* board;                  // Tabuleiro em textura (não nulo apenas em grids enormes).
+    Shader* boardShader;                  // Shader que pinta cada pixel com o código da sua célula.
+    GpuTimer* gpuTimer;                   // Tempo de cada passagem na GPU (nulo sem SNAKE_INSTRUMENTATION).
+    // Localizações dos uniforms de 'segmentShader' que mudam a cada frame.
+    int headSlotLoc, segmentCountLoc, previousTailLoc, alphaLoc, foodLoc;
+
+    // --- MODO OCIOSO ---
+    // Em vez de desenhar sem parar, desenha só quando algo muda e dorme até o próximo passo.
+    bool idleRendering;                   // Verdadeiro se o modo ocioso está ligado (SNAKE_IDLE=1).
+    bool needsRedraw;                     // Verdadeiro se algo mudou desde o último frame desenhado.
 
     // --- MÉTODOS PRIVADOS ---
     // Inicializa a janela, OpenGL, shaders e os objetos do jogo.
     void init();
+    // Define os uniforms fixos dos shaders e guarda as localizações dos que mudam a cada frame.
+    void configureShaders();
+    // Compila os shaders alterados em disco e troca os que compilarem sem erro.
+    void reloadShaders();
     // Processa as entradas do usuário (teclado).
     void processInput();
-    // Atualiza o estado do jogo (movimento da cobra, colisões, etc.).
+    // Avança a simulação em um passo e trata o fim de partida (thread da simulação).
     void update();
+    // Loop da thread da simulação: executa os passos no horário e publica as fotografias.
+    void simulationLoop();
+    // Aplica a fotografia mais recente ao estado do desenho. Retorna falso se não há nova.
+    bool consumeSnapshot();
     // Desenha todos os elementos do jogo na tela.
-    void render();
+    // 'alpha' (de 0 a 1) é a fração do intervalo entre dois passos que já passou,
+    // usada para desenhar a cobra entre a posição anterior e a atual.
+    void render(float alpha);
+
+    // Sincroniza 'segments' e desenha a cobra e a comida com uma única chamada instanciada.
+    void drawSnake(float alpha);
 
-    // Reinicia o jogo para o estado inicial.
-    void resetGame();
-    // Gera uma nova posição para a comida, garantindo que não apareça sobre a cobra.
-    GridPosition generateNewFood();
-    // Desenha um único quadrado no grid (usado para a cobra e a comida).
-    void drawSquare(const GridPosition& position, const glm::vec4& color);
+    // Diretório do cache de programas de shader (vazio se o cache estiver desligado).
+    static std::string shaderCacheDirectory();
 
     // Função de callback estática para redimensionar a janela.
     static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+    // Funções de callback que pedem um novo frame (tecla pressionada, janela exposta).
+    static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void window_refresh_callback(GLFWwindow* window);
+    // Marca que o jogo dono de 'window' precisa redesenhar a tela.
+    static void requestRedraw(GLFWwindow* window);
 };
 
 #endif
@@ -0,0 +1,78 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+// Inclui o cabeçalho do GLAD para as funções do OpenGL.
+#include <glad/glad.h>
+// Inclui as métricas, onde os tempos medidos são registrados.
+#include "Instrumentation.h"
+
+// Mede quanto tempo a GPU (ou o llvmpipe) leva para executar cada passagem do frame, com
+// consultas GL_TIME_ELAPSED. Um cronômetro na CPU em volta de 'render' mede só o envio dos
+// comandos; a execução acontece depois, na GPU.
+// O resultado de uma consulta só fica pronto alguns frames depois. Pedir o resultado antes
+// disso faria a CPU esperar a GPU, então as consultas ficam em um anel de FRAME_LATENCY
+// frames: cada frame lê as consultas de FRAME_LATENCY frames atrás, que normalmente já
+// terminaram. Se ainda não terminaram, o frame atual simplesmente não é medido.
+// Os tempos vão para as métricas GPU_* (veja Instrumentation.h).
+// Requer um contexto OpenGL ativo na construção, no uso e na destruição.
+class GpuTimer {
+public:
+    // Frames entre uma consulta e a leitura do seu resultado, e passagens medidas por frame.
+    static const int FRAME_LATENCY = 4;
+    static const int MAX_PASSES = 4;
+
+    GpuTimer();
+    ~GpuTimer();
+
+    // O objeto é dono de recursos do OpenGL, então não pode ser copiado.
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // Começa um frame: registra os resultados que já ficaram prontos e libera as
+    // consultas da posição do anel que este frame vai usar.
+    void beginFrame();
+    // Começa e termina a medição de uma passagem. Só uma passagem pode estar aberta por vez.
+    void begin(Metric pass);
+    void end();
+
+private:
+    // Uma consulta e a métrica em que o seu resultado será registrado.
+    struct Query {
+        unsigned int id;
+        Metric metric;
+    };
+
+    Query queries[FRAME_LATENCY][MAX_PASSES]; // Consultas de cada posição do anel.
+    int used[FRAME_LATENCY];                  // Consultas feitas (ainda não lidas) em cada posição.
+    int frame;                                // Posição do anel usada pelo frame atual.
+    bool skipping;                            // Verdadeiro se o frame atual não é medido.
+    bool open;                                // Verdadeiro entre 'begin' e 'end'.
+};
+
+// Mede o restante do bloco atual como uma passagem de 'timer' (que pode ser nulo).
+class GpuTimerScope {
+public:
+    GpuTimerScope(GpuTimer* timer, Metric pass) : timer(timer)
+    {
+        if (timer != nullptr)
+        {
+            timer->begin(pass);
+        }
+    }
+    ~GpuTimerScope()
+    {
+        if (timer != nullptr)
+        {
+            timer->end();
+        }
+    }
+
+    GpuTimerScope(const GpuTimerScope&) = delete;
+    GpuTimerScope& operator=(const GpuTimerScope&) = delete;
+
+private:
+    GpuTimer* timer;
+};
+
+#endif
@@ -0,0 +1,19 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef GRID_POSITION_H
+#define GRID_POSITION_H
+
+// Estrutura para representar uma posição (x, y) no grid.
+// É mais simples que uma classe e serve bem para agrupar dados.
+struct GridPosition {
+    int x; // Coordenada X
+    int y; // Coordenada Y
+
+    // Sobrecarga do operador de igualdade (==).
+    // Permite comparar duas instâncias de GridPosition diretamente (ex: pos1 == pos2).
+    // É 'const' porque não modifica nenhum dos objetos que está comparando.
+    bool operator==(const GridPosition& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+#endif
@@ -0,0 +1,133 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+// Inclui as operações atômicas e os tipos inteiros de tamanho fixo.
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+// Inclui a definição de Direction.
+#include "Snake.h"
+
+// Uma tecla de direção pressionada, com o instante (em segundos) em que chegou.
+struct InputEvent {
+    Direction direction; // Direção pedida pela tecla.
+    double time;         // Instante do evento, no mesmo relógio usado para os passos.
+};
+
+// Fila de um produtor e um consumidor (SPSC) sem travas, de capacidade fixa.
+// O produtor só escreve 'tail' e o consumidor só escreve 'head'; cada lado lê o índice
+// do outro com 'acquire' e publica o seu com 'release', o que basta para que um elemento
+// seja visto por inteiro. 'Capacity' deve ser uma potência de 2 (o índice usa uma máscara).
+// 'push' e 'pop' nunca bloqueiam: com a fila cheia, 'push' descarta o elemento.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "A capacidade da fila deve ser uma potência de 2");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Chamado apenas pelo produtor. Retorna falso se a fila estiver cheia.
+    bool push(const T& value)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        items[t & (Capacity - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Chamado apenas pelo consumidor. Retorna falso se a fila estiver vazia.
+    bool pop(T& value)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    // Os índices só crescem (a posição é o índice com a máscara); ficam em linhas de cache
+    // separadas para que o produtor e o consumidor não disputem a mesma linha.
+    alignas(64) std::atomic<size_t> head; // Próximo elemento a ler (escrito pelo consumidor).
+    alignas(64) std::atomic<size_t> tail; // Próxima posição a escrever (escrita pelo produtor).
+};
+
+// Curvas já aceitas e ainda não aplicadas, no máximo 'MAX_TURNS', uma aplicada por passo.
+// Cada curva é validada contra a última curva guardada (ou contra a direção atual da cobra,
+// se não houver nenhuma), não contra a direção atual: assim, CIMA e logo ESQUERDA dentro do
+// mesmo passo viram duas curvas seguidas, e CIMA seguido de BAIXO não inverte a cobra.
+class TurnBuffer {
+public:
+    static const size_t MAX_TURNS = 3;
+
+    TurnBuffer() : first(0), count(0) {}
+
+    // Tenta guardar uma curva. 'current' é a direção em que a cobra anda agora.
+    // Retorna falso (e descarta a curva) se ela não muda nada, inverte a cobra ou não cabe.
+    bool push(const InputEvent& event, Direction current)
+    {
+        Direction last = count > 0 ? turns[(first + count - 1) % MAX_TURNS].direction : current;
+        if (event.direction == last || Snake::isOpposite(last, event.direction) || count == MAX_TURNS)
+        {
+            return false;
+        }
+        turns[(first + count) % MAX_TURNS] = event;
+        ++count;
+        return true;
+    }
+
+    // Retira a curva mais antiga. Retorna falso se não houver nenhuma.
+    bool pop(InputEvent& event)
+    {
+        if (count == 0)
+        {
+            return false;
+        }
+        event = turns[first];
+        first = (first + 1) % MAX_TURNS;
+        --count;
+        return true;
+    }
+
+    // Descarta todas as curvas (ex: quando a partida reinicia).
+    void clear() { first = 0; count = 0; }
+    size_t size() const { return count; }
+
+private:
+    InputEvent turns[MAX_TURNS]; // Curvas guardadas, em ordem circular a partir de 'first'.
+    size_t first;                // Posição da curva mais antiga.
+    size_t count;                // Número de curvas guardadas.
+};
+
+// Estatísticas da latência entre uma tecla e o passo que aplicou a curva.
+// As teclas perdidas com a fila cheia são contadas à parte, em 'Game::droppedInputs', porque
+// quem as perde é o callback do teclado, em outra thread.
+struct InputLatencyStats {
+    uint64_t applied = 0;   // Curvas aplicadas.
+    uint64_t rejected = 0;  // Teclas descartadas (inversão, repetição ou buffer cheio).
+    double total = 0.0;     // Soma das latências, em segundos.
+    double max = 0.0;       // Maior latência, em segundos.
+
+    void record(double latency)
+    {
+        ++applied;
+        total += latency;
+        if (latency > max)
+        {
+            max = latency;
+        }
+    }
+    double mean() const { return applied > 0 ? total / (double)applied : 0.0; }
+};
+
+#endif
@@ -0,0 +1,124 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+// Inclui as operações atômicas, o relógio monotônico e os tipos inteiros de tamanho fixo.
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+// Histograma de latências no estilo HDR: guarda a distribuição inteira, não só a média,
+// com erro relativo máximo de 1/128 (< 0,8%) em qualquer faixa de valores.
+// Os valores (em nanossegundos) são agrupados em oitavas (potências de 2), e cada oitava é
+// dividida em 128 faixas iguais; valores abaixo de 128 ns têm uma faixa cada. Registrar um
+// valor custa um cálculo de índice e um incremento, sem alocação e sem travas.
+// Cada histograma deve ter uma única thread que registra; outras threads podem ler
+// (os contadores são atômicos, então a leitura nunca vê um valor pela metade).
+class LatencyHistogram {
+public:
+    // Faixas por oitava (2^SUB_BUCKET_BITS) e maior oitava registrada (2^40 ns, ~18 minutos).
+    static const int SUB_BUCKET_BITS = 7;
+    static const int MAX_OCTAVE = 40;
+    static const size_t SUB_BUCKETS = (size_t)1 << SUB_BUCKET_BITS;
+    // Uma linha de faixas exatas (abaixo de 128 ns) e uma linha por oitava a partir de 2^7 ns.
+    static const size_t BUCKET_COUNT = SUB_BUCKETS * (MAX_OCTAVE - SUB_BUCKET_BITS + 2);
+
+    LatencyHistogram();
+
+    // Registra um valor, em nanossegundos. Valores acima de 2^40 ns contam como o maior.
+    void record(uint64_t nanoseconds);
+    // Zera o histograma. Não deve ser chamado enquanto outra thread registra.
+    void reset();
+
+    // Número de valores registrados.
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    // Maior valor registrado (exato).
+    uint64_t max() const { return maximum.load(std::memory_order_relaxed); }
+    // Média dos valores registrados.
+    double mean() const;
+    // Valor abaixo do qual está a fração 'q' (de 0 a 1) dos valores, com a precisão da faixa.
+    // Retorna o maior valor da faixa (nunca acima do máximo registrado).
+    uint64_t percentile(double q) const;
+
+private:
+    // Índice da faixa de um valor, e o maior valor que cai na faixa 'index'.
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketHighest(size_t index);
+
+    // Com uma única thread registrando, 'load' + 'store' bastam (sem instruções atômicas
+    // de leitura-modificação-escrita), e o custo fica igual ao de um contador comum.
+    static void increment(std::atomic<uint64_t>& counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> buckets[BUCKET_COUNT]; // Contagem de cada faixa.
+    std::atomic<uint64_t> total;                 // Número de valores.
+    std::atomic<uint64_t> sum;                   // Soma dos valores (para a média).
+    std::atomic<uint64_t> maximum;               // Maior valor.
+};
+
+// Métricas de tempo do jogo. Cada uma é registrada por uma única thread.
+enum class Metric {
+    INPUT,          // 'processInput' (thread principal).
+    RENDER,         // 'render': envio dos comandos de desenho (thread principal).
+    SWAP,           // 'glfwSwapBuffers' (thread principal).
+    EVENTS,         // 'glfwPollEvents' ou 'glfwWaitEvents' (thread principal).
+    FRAME,          // Intervalo entre o início de dois frames (thread principal).
+    TICK,           // Um passo da simulação, 'update' (thread da simulação).
+    INPUT_LATENCY,  // Da tecla pressionada até o passo que aplicou a curva (thread da simulação).
+    GPU_CLEAR,      // Execução de 'glClear' na GPU (veja GpuTimer).
+    GPU_SNAKE,      // Execução do desenho da cobra e da comida (ou do tabuleiro em textura) na GPU.
+    GPU_GRID,       // Execução do desenho do grid na GPU.
+    COUNT
+};
+
+#ifdef SNAKE_INSTRUMENTATION
+
+// Histograma de uma métrica (um por métrica, para o processo inteiro).
+LatencyHistogram& metricHistogram(Metric metric);
+// Escreve p50, p99, p99.9 e o máximo de cada métrica com algum valor registrado.
+void printMetrics(std::ostream& out);
+// Faz o sinal SIGUSR1 pedir uma impressão das métricas (onde o sinal existe).
+// O tratador só marca o pedido; quem imprime é o loop do jogo (veja 'takeMetricsRequest').
+void installMetricsSignal();
+// Retorna verdadeiro (uma vez) se um SIGUSR1 chegou desde a última chamada.
+bool takeMetricsRequest();
+
+// Mede o tempo de vida do objeto e o registra em uma métrica ao sair do escopo.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Metric metric)
+        : histogram(metricHistogram(metric)), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer()
+    {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        histogram.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Mede o restante do bloco atual na métrica 'metric' (ex: SNAKE_TIMED_SCOPE(Metric::RENDER)).
+#define SNAKE_TIMED_SCOPE_CONCAT2(a, b) a##b
+#define SNAKE_TIMED_SCOPE_CONCAT(a, b) SNAKE_TIMED_SCOPE_CONCAT2(a, b)
+#define SNAKE_TIMED_SCOPE(metric) ScopedTimer SNAKE_TIMED_SCOPE_CONCAT(scopedTimer, __LINE__)(metric)
+// Registra um valor já medido, em nanossegundos.
+#define SNAKE_RECORD_METRIC(metric, nanoseconds) metricHistogram(metric).record(nanoseconds)
+
+#else
+
+// Sem SNAKE_INSTRUMENTATION, as medições desaparecem do código compilado.
+#define SNAKE_TIMED_SCOPE(metric) ((void)0)
+#define SNAKE_RECORD_METRIC(metric, nanoseconds) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+// Inclui vetores e algoritmos da STL e os tipos inteiros de tamanho fixo.
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+// Inclui a definição de GridPosition.
+#include "GridPosition.h"
+
+// Mapa de bits com um bit por célula do grid: 1 = ocupada pela cobra, 0 = livre.
+// Responde "esta célula está ocupada?" em O(1), independente do tamanho da cobra.
+// Os bits são agrupados em palavras de 64 bits, então um grid de 4096x4096
+// ocupa apenas 2 MB.
+class OccupancyGrid {
+public:
+    // Construtor: cria um grid vazio com as dimensões fornecidas.
+    OccupancyGrid(int width, int height)
+        : width(width), height(height),
+          words(((size_t)width * (size_t)height + 63) / 64, 0) {}
+
+    // Verifica se a posição está dentro dos limites do grid.
+    // A conversão para 'unsigned' trata coordenadas negativas como valores enormes,
+    // fazendo o teste com uma única comparação por eixo.
+    bool contains(const GridPosition& p) const
+    {
+        return (unsigned)p.x < (unsigned)width && (unsigned)p.y < (unsigned)height;
+    }
+
+    // Retorna verdadeiro se a célula estiver ocupada. A posição deve estar dentro do grid.
+    bool test(const GridPosition& p) const
+    {
+        size_t i = index(p);
+        return (words[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    // Marca a célula como ocupada.
+    void set(const GridPosition& p)
+    {
+        size_t i = index(p);
+        words[i >> 6] |= (uint64_t)1 << (i & 63);
+    }
+
+    // Marca a célula como livre.
+    void reset(const GridPosition& p)
+    {
+        size_t i = index(p);
+        words[i >> 6] &= ~((uint64_t)1 << (i & 63));
+    }
+
+    // Libera todas as células.
+    void clear()
+    {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    // Converte uma posição (x, y) para o índice linear da célula.
+    size_t index(const GridPosition& p) const
+    {
+        return (size_t)p.y * (size_t)width + (size_t)p.x;
+    }
+
+    int width;                  // Largura do grid (em células).
+    int height;                 // Altura do grid (em células).
+    std::vector<uint64_t> words; // Bits de ocupação, 64 células por palavra.
+};
+
+#endif
@@ -0,0 +1,79 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// Inclui os tipos inteiros de tamanho fixo.
+#include <cstdint>
+
+// Gerador de números pseudoaleatórios PCG32 (O'Neill, 2014).
+// Cada partida tem o seu próprio gerador, com apenas 16 bytes de estado, em vez de
+// compartilhar o 'rand()' global da libc. Isso torna as partidas reproduzíveis
+// (mesma semente = mesma sequência em qualquer máquina) e permite rodar partidas
+// em threads diferentes sem disputa por um estado escondido.
+class Random {
+public:
+    // Construtor: 'seed' escolhe o ponto de partida da sequência e 'stream' escolhe uma
+    // de 2^63 sequências independentes (útil para dar um gerador a cada partida de um lote).
+    explicit Random(uint64_t seed = 0, uint64_t stream = 0)
+    {
+        this->seed(seed, stream);
+    }
+
+    // Reinicia o gerador com uma nova semente, seguindo a inicialização de referência do PCG.
+    void seed(uint64_t seed, uint64_t stream = 0)
+    {
+        state = 0;
+        increment = (stream << 1) | 1u; // O incremento precisa ser ímpar.
+        next();
+        state += seed;
+        next();
+    }
+
+    // Retorna o próximo número de 32 bits da sequência.
+    uint32_t next()
+    {
+        uint64_t old = state;
+        // Avança o gerador congruencial linear de 64 bits.
+        state = old * 6364136223846793005ULL + increment;
+        // Embaralha os bits do estado antigo (xorshift seguido de uma rotação aleatória).
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = (uint32_t)(old >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+    }
+
+    // Retorna um inteiro uniforme em [0, bound), com 'bound' > 0.
+    // Usa o método de Lemire (multiplicação + rejeição rara) em vez de 'next() % bound',
+    // que favorece os valores pequenos quando 'bound' não divide 2^32.
+    uint32_t nextBounded(uint32_t bound)
+    {
+        uint64_t product = (uint64_t)next() * bound;
+        uint32_t low = (uint32_t)product;
+        if (low < bound)
+        {
+            // Limiar abaixo do qual o resultado seria enviesado: 2^32 mod bound.
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold)
+            {
+                product = (uint64_t)next() * bound;
+                low = (uint32_t)product;
+            }
+        }
+        return (uint32_t)(product >> 32);
+    }
+
+    // --- ESTADO INTERNO ---
+    // Permitem salvar e restaurar o ponto exato da sequência (usado nos keyframes de replay).
+    uint64_t getState() const { return state; }
+    uint64_t getIncrement() const { return increment; }
+    void setState(uint64_t newState, uint64_t newIncrement)
+    {
+        state = newState;
+        increment = newIncrement;
+    }
+
+private:
+    uint64_t state;     // Estado interno do gerador.
+    uint64_t increment; // Seleciona a sequência (stream); sempre ímpar.
+};
+
+#endif
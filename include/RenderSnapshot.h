@@ -0,0 +1,75 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+// Inclui vetores da STL, as operações atômicas e os tipos inteiros de tamanho fixo.
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+// Inclui as regras do jogo (estado da partida e resultado de um passo).
+#include "Simulation.h"
+// Inclui o buffer triplo pelo qual as fotografias passam de uma thread para a outra.
+#include "TripleBuffer.h"
+
+// Um movimento da cobra: a nova cabeça e se ela cresceu (o rabo ficou no lugar).
+// Aplicar os movimentos em ordem a uma cópia do corpo reproduz o corpo da simulação.
+struct SnakeMove {
+    GridPosition head;
+    bool grew;
+};
+
+// Fotografia do que o desenho precisa de uma partida, depois de um passo.
+// Copiar o corpo inteiro a cada passo custaria O(tamanho da cobra); por isso a fotografia
+// normalmente traz só os movimentos que o leitor ainda não viu, e o leitor os aplica à
+// sua própria cópia do corpo. O corpo inteiro só vem ('full') depois de um reinício da
+// partida ou se o leitor ficou muitos passos para trás.
+struct RenderSnapshot {
+    uint64_t tick = 0;               // Passos simulados na sessão (não volta a zero nos reinícios).
+    double time = 0.0;               // Instante (em segundos) previsto para este passo.
+    GridPosition food = {0, 0};      // Posição da comida.
+    bool hasFood = false;            // Falso quando a cobra ocupa o grid inteiro.
+    GridPosition previousTail = {0, 0}; // Posição do rabo antes do último movimento.
+    size_t length = 0;               // Tamanho da cobra.
+    int score = 0;                   // Pontuação da partida.
+
+    bool full = false;               // Verdadeiro se 'body' traz o corpo inteiro.
+    std::vector<GridPosition> body;  // Corpo inteiro, da cabeça ao rabo (só se 'full').
+    uint64_t firstMoveTick = 0;      // Passo do primeiro movimento de 'moves'.
+    std::vector<SnakeMove> moves;    // Movimentos dos passos [firstMoveTick, tick].
+};
+
+// Lado da simulação: guarda os últimos movimentos da cobra e publica fotografias.
+// O leitor informa o último passo que aplicou ('acknowledge'), e cada fotografia traz
+// os movimentos desde esse passo, ou o corpo inteiro se eles não estiverem mais guardados.
+// 'recordStep' e 'publish' devem ser chamados pela mesma thread; 'acknowledge' pela outra.
+class SnapshotPublisher {
+public:
+    // Número de movimentos guardados. Um leitor mais atrasado que isso recebe o corpo inteiro.
+    static const size_t MAX_MOVES = 1024;
+
+    explicit SnapshotPublisher(TripleBuffer<RenderSnapshot>& buffer);
+
+    // Registra um passo de 'step'. Deve ser chamado depois de um eventual reinício da
+    // partida ('restarted'), com 'state' já no estado que o próximo passo vai usar.
+    void recordStep(const GameState& state, const StepResult& result, bool restarted);
+    // Preenche e publica uma fotografia de 'state'. 'time' é o instante do último passo.
+    void publish(const GameState& state, double time);
+    // Chamado pelo leitor com o passo da última fotografia aplicada.
+    void acknowledge(uint64_t tick) { acknowledged.store(tick, std::memory_order_release); }
+
+    // Número de passos registrados.
+    uint64_t getTick() const { return tick; }
+
+private:
+    // Valor de 'acknowledged' antes da primeira fotografia lida.
+    static const uint64_t NONE = UINT64_MAX;
+
+    TripleBuffer<RenderSnapshot>& buffer; // Buffer triplo compartilhado com o leitor.
+    std::vector<SnakeMove> recent;        // Últimos movimentos, na posição 'passo % MAX_MOVES'.
+    uint64_t tick;                        // Passos registrados.
+    uint64_t restartTick;                 // Passo em que a partida atual começou.
+    std::atomic<uint64_t> acknowledged;   // Último passo aplicado pelo leitor.
+};
+
+#endif
@@ -0,0 +1,150 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Inclui strings, vetores, arquivos e os tipos inteiros de tamanho fixo.
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+// Inclui as regras do jogo, usadas para re-simular as partidas gravadas.
+#include "Simulation.h"
+
+// --- FORMATO DO ARQUIVO DE REPLAY ---
+// Todos os inteiros são gravados em little-endian.
+//
+// Cabeçalho (24 bytes):
+//   "SNKR" | versão (u32) | largura do grid (i32) | altura do grid (i32) | semente (u64)
+//
+// Seguido de blocos, apenas acrescentados ao fim do arquivo:
+//   tipo (u8) | 3 bytes reservados | quantidade (u32) | dados
+//
+// Bloco REPLAY_BLOCK_TICKS: 'quantidade' passos, cada um com a direção em que a cobra
+// andou (2 bits, valores de Direction), 4 passos por byte, o primeiro nos bits baixos.
+//
+// Bloco REPLAY_BLOCK_KEYFRAME (versão 2): estado completo da partida depois de um passo,
+// com 'quantidade' = tamanho dos dados em bytes:
+//   passo (u64) | direção (u32) | comida x, y (i32, i32) | estado e incremento do gerador
+//   (u64, u64) | tamanho da cobra (u32) | número de células livres (u32) |
+//   células do corpo, da cabeça ao rabo | células livres, na ordem do conjunto
+// As células são gravadas como u32 (y * largura + x). A ordem das células livres é
+// gravada porque o sorteio da comida escolhe uma posição desse conjunto.
+//
+// Como a simulação é determinística, a semente e as direções bastam para reproduzir
+// todas as partidas da sessão, inclusive os reinícios depois de cada fim de jogo.
+// Os keyframes só servem para pular até um passo qualquer sem re-simular desde o início.
+const uint32_t REPLAY_VERSION = 2;
+const uint8_t REPLAY_BLOCK_TICKS = 1;
+const uint8_t REPLAY_BLOCK_KEYFRAME = 2;
+// Média máxima de bytes de keyframe por passo gravado (os passos em si custam 1/4 de byte).
+const uint32_t KEYFRAME_BYTES_PER_TICK = 1;
+
+// Grava um replay enquanto o jogo roda.
+// As direções ficam em memória e são escritas em blocos, então gravar um passo custa
+// apenas alguns bits; um bloco incompleto é escrito em 'flush' ou no destrutor.
+class ReplayWriter {
+public:
+    // Construtor: cria (ou sobrescreve) o arquivo e grava o cabeçalho.
+    // Um keyframe é gravado a cada 'keyframeInterval' passos (0 desliga os keyframes).
+    // Um keyframe ocupa 4 bytes por célula do grid (64 MB em 4096x4096) e é escrito na
+    // thread da simulação, então em grids grandes o intervalo é aumentado para que os
+    // keyframes custem, em média, no máximo KEYFRAME_BYTES_PER_TICK bytes por passo.
+    ReplayWriter(const char* path, int gridWidth, int gridHeight, uint64_t seed,
+                 uint32_t keyframeInterval = 8192);
+    // Destrutor: grava os passos pendentes e fecha o arquivo.
+    ~ReplayWriter();
+
+    // Registra a direção em que a cobra andou em um passo.
+    void record(Direction direction);
+    // Deve ser chamado ao fim de cada passo, depois de um eventual reinício da partida.
+    // Grava um keyframe com 'state' quando o intervalo de keyframes é atingido.
+    void recordState(const GameState& state);
+    // Grava no arquivo os passos ainda em memória.
+    void flush();
+
+    // Retorna falso se o arquivo não pôde ser criado.
+    bool isOpen() const { return file.is_open(); }
+
+private:
+    std::ofstream file;             // Arquivo de saída.
+    std::vector<uint8_t> packed;    // Direções do bloco atual, 4 por byte.
+    uint32_t pendingTicks;          // Número de passos no bloco atual.
+    uint64_t totalTicks;            // Número de passos gravados desde o início.
+    uint32_t keyframeInterval;      // Passos entre dois keyframes.
+    std::vector<uint8_t> keyframe;  // Memória reaproveitada para montar os keyframes.
+};
+
+// Estatísticas de uma re-simulação.
+struct ReplayStats {
+    uint64_t ticks;   // Passos simulados.
+    uint64_t games;   // Partidas terminadas (derrotas e vitórias).
+    uint64_t wins;    // Partidas vencidas.
+    int bestScore;    // Maior pontuação alcançada.
+};
+
+// Lê um replay mapeando o arquivo na memória (mmap), sem copiá-lo, e re-simula as
+// partidas na velocidade máxima da CPU, sem janela.
+class ReplayReader {
+public:
+    // Construtor: abre e mapeia o arquivo e valida o cabeçalho e o tamanho dos keyframes.
+    explicit ReplayReader(const char* path);
+    // Destrutor: desfaz o mapeamento.
+    ~ReplayReader();
+
+    // O leitor é dono do mapeamento, então não pode ser copiado.
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    // Retorna falso se o arquivo não existe ou não é um replay válido.
+    bool isOpen() const { return data != nullptr; }
+
+    // --- DADOS DO CABEÇALHO ---
+    int getGridWidth() const { return gridWidth; }
+    int getGridHeight() const { return gridHeight; }
+    uint64_t getSeed() const { return seed; }
+    // Número total de passos gravados.
+    uint64_t getTickCount() const { return tickCount; }
+
+    // Re-simula os primeiros 'ticks' passos gravados (todos, por padrão), aplicando as
+    // mesmas regras de reinício do jogo, sem usar os keyframes.
+    // 'state' deve ser uma partida nova, criada com as dimensões e a semente do arquivo:
+    // GameState state(reader.getGridWidth(), reader.getGridHeight(), reader.getSeed());
+    // Ao final, 'state' contém o estado do último passo re-simulado.
+    ReplayStats simulate(GameState& state, uint64_t ticks = UINT64_MAX) const;
+
+    // Coloca em 'state' o estado da partida depois de 'tick' passos (0 = início).
+    // Encontra o keyframe mais próximo antes de 'tick' por busca binária no índice
+    // (O(log n)) e re-simula apenas os passos entre ele e 'tick'.
+    // 'state' deve ter as dimensões do arquivo. Retorna falso (sem alterar 'state') se 'tick'
+    // passar do fim ou se o keyframe usado estiver corrompido.
+    bool seek(uint64_t tick, GameState& state) const;
+
+    // Número de keyframes encontrados no arquivo.
+    size_t getKeyframeCount() const { return keyframes.size(); }
+    // Passo do i-ésimo keyframe, com i em [0, getKeyframeCount()).
+    uint64_t getKeyframeTick(size_t i) const { return keyframes[i].tick; }
+
+private:
+    // Entrada do índice: o estado depois de 'tick' passos está no bloco em 'offset'.
+    struct KeyframeEntry {
+        uint64_t tick;
+        size_t offset;
+    };
+
+    // Desfaz o mapeamento e marca o leitor como fechado.
+    void release();
+    // Re-simula até 'ticks' passos a partir dos blocos que começam em 'offset'.
+    ReplayStats simulateFrom(size_t offset, uint64_t ticks, GameState& state) const;
+
+    const uint8_t* data; // Início do arquivo mapeado na memória.
+    size_t size;         // Tamanho do arquivo (e do mapeamento) em bytes.
+    size_t validSize;    // Bytes até o fim do último bloco completo.
+    int gridWidth;       // Largura do grid gravada no cabeçalho.
+    int gridHeight;      // Altura do grid gravada no cabeçalho.
+    uint64_t seed;       // Semente gravada no cabeçalho.
+    uint64_t tickCount;  // Soma dos passos de todos os blocos.
+    std::vector<KeyframeEntry> keyframes; // Índice dos keyframes, em ordem de passo.
+};
+
+#endif
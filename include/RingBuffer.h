@@ -0,0 +1,92 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+// Inclui a biblioteca de vetores da STL para o armazenamento interno e size_t.
+#include <vector>
+#include <cstddef>
+
+// Buffer circular de capacidade fixa, usado para guardar o corpo da cobra.
+// Inserir na frente (cabeça) e remover do fim (rabo) custam O(1), sem deslocar
+// nenhum elemento na memória, ao contrário de 'vector::insert(begin(), ...)'.
+// O índice lógico 0 é sempre a frente (cabeça) e 'size() - 1' é o fim (rabo).
+template <typename T>
+class RingBuffer {
+public:
+    // Iterador constante que percorre o buffer da frente para o fim.
+    // Permite usar o buffer em laços 'for (const auto& x : buffer)'.
+    class const_iterator {
+    public:
+        const_iterator(const RingBuffer* buffer, size_t index) : buffer(buffer), index(index) {}
+
+        const T& operator*() const { return (*buffer)[index]; }
+        const T* operator->() const { return &(*buffer)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+    private:
+        const RingBuffer* buffer; // Buffer que está sendo percorrido.
+        size_t index;             // Índice lógico atual (0 = frente).
+    };
+
+    // Construtor: reserva de uma só vez todo o espaço necessário.
+    // 'capacity' é o número máximo de elementos que o buffer pode conter.
+    explicit RingBuffer(size_t capacity)
+        : data(capacity > 0 ? capacity : 1), start(0), count(0) {}
+
+    // Insere um elemento na frente do buffer (nova cabeça).
+    // Se o buffer estiver cheio, o elemento do fim é sobrescrito.
+    void push_front(const T& value)
+    {
+        // Recua o início uma posição, voltando para o fim do vetor se necessário.
+        start = (start == 0) ? data.size() - 1 : start - 1;
+        data[start] = value;
+        if (count < data.size())
+        {
+            ++count;
+        }
+    }
+
+    // Remove o elemento do fim do buffer (rabo). Basta diminuir a contagem.
+    void pop_back()
+    {
+        --count;
+    }
+
+    // Esvazia o buffer sem liberar a memória reservada.
+    void clear()
+    {
+        start = 0;
+        count = 0;
+    }
+
+    // Acessa o i-ésimo elemento a partir da frente (0 = cabeça).
+    // Evita o operador '%' subtraindo a capacidade quando o índice dá a volta.
+    const T& operator[](size_t i) const { return data[slot(i)]; }
+
+    // Retorna a posição física (no vetor interno) do i-ésimo elemento lógico.
+    size_t slot(size_t i) const
+    {
+        size_t physical = start + i;
+        return physical >= data.size() ? physical - data.size() : physical;
+    }
+
+    // --- MÉTODOS DE ACESSO ---
+    const T& front() const { return data[start]; }
+    const T& back() const { return (*this)[count - 1]; }
+    size_t size() const { return count; }
+    size_t capacity() const { return data.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == data.size(); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+private:
+    std::vector<T> data; // Armazenamento contíguo, alocado uma única vez.
+    size_t start;        // Posição física da frente (cabeça) no vetor 'data'.
+    size_t count;        // Número de elementos atualmente no buffer.
+};
+
+#endif
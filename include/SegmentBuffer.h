@@ -0,0 +1,61 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef SEGMENT_BUFFER_H
+#define SEGMENT_BUFFER_H
+
+// Inclui o cabeçalho do GLAD para as funções do OpenGL.
+#include <glad/glad.h>
+// Inclui vetores da STL e os tipos inteiros de tamanho fixo.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+// Inclui o buffer circular do corpo da cobra e a definição de GridPosition.
+#include "RingBuffer.h"
+#include "GridPosition.h"
+
+// Cópia do corpo da cobra na GPU, organizada como o mesmo buffer circular da CPU.
+// Cada segmento fica na mesma posição física que ocupa no 'RingBuffer' do corpo, então um
+// passo só muda a posição da nova cabeça (o rabo que sai apenas deixa de ser desenhado).
+// 'sync' envia para a GPU somente as posições que mudaram desde a última chamada, e o
+// vertex shader lê os segmentos por uma textura de buffer ('samplerBuffer'), somando a
+// posição física da cabeça ao índice da instância para dar a volta no anel.
+// Requer um contexto OpenGL ativo na construção e na destruição.
+class SegmentBuffer {
+public:
+    // Construtor: reserva na GPU espaço para 'capacity' segmentos (a capacidade do corpo).
+    explicit SegmentBuffer(size_t capacity);
+    // Destrutor: libera o buffer e a textura.
+    ~SegmentBuffer();
+
+    // O objeto é dono de recursos do OpenGL, então não pode ser copiado.
+    SegmentBuffer(const SegmentBuffer&) = delete;
+    SegmentBuffer& operator=(const SegmentBuffer&) = delete;
+
+    // Força o envio do corpo inteiro na próxima sincronização.
+    // Deve ser chamado quando o corpo é refeito sem passar por 'push_front' (reinício da partida).
+    void invalidate();
+    // Envia para a GPU as cabeças novas desde a última chamada (ou o corpo inteiro,
+    // se o buffer foi invalidado). 'body' deve ter a capacidade passada ao construtor.
+    void sync(const RingBuffer<GridPosition>& body);
+    // Associa a textura de buffer à unidade de textura 'unit'.
+    void bind(unsigned int unit) const;
+
+    // Posição física da cabeça no anel (o uniform 'headSlot' do shader).
+    size_t getHeadSlot() const { return headSlot; }
+    // Número de segmentos enviados na última sincronização (para diagnóstico).
+    size_t getLastUploadCount() const { return lastUploadCount; }
+
+private:
+    // Envia os segmentos lógicos [first, first + count) do corpo (0 = cabeça), em até
+    // dois trechos contíguos do buffer (antes e depois da volta do anel).
+    void upload(const RingBuffer<GridPosition>& body, size_t first, size_t count);
+
+    unsigned int buffer;           // Buffer com as células (x, y) de cada posição do anel.
+    unsigned int texture;          // Textura de buffer que expõe 'buffer' ao shader.
+    size_t capacity;               // Número de posições do anel.
+    size_t headSlot;               // Posição física da cabeça na última sincronização.
+    bool valid;                    // Falso quando o corpo inteiro precisa ser reenviado.
+    size_t lastUploadCount;        // Segmentos enviados na última sincronização.
+    std::vector<int32_t> staging;  // Memória reaproveitada para montar os envios.
+};
+
+#endif
@@ -4,7 +4,12 @@
 
 // Inclui a biblioteca de strings da STL e o cabeçalho do GLAD para as funções do OpenGL.
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
 #include <glad/glad.h>
+// Inclui os tipos de vetores e matrizes da GLM, usados pelos setters de uniforms.
+#include <glm/glm.hpp>
 
 // A classe Shader encapsula a lógica para carregar, compilar e gerenciar
 // um programa de shader do OpenGL (que consiste em um vertex e um fragment shader).
@@ -13,31 +18,113 @@ class Shader {
     // O ID do programa de shader, que é um número de referência usado pelo OpenGL.
     unsigned int ID;
 
-    // Construtor: lê e compila os shaders a partir dos caminhos dos arquivos fornecidos.
-    // vertexPath: caminho para o arquivo do vertex shader (código .vert).
-    // fragmentPath: caminho para o arquivo do fragment shader (código .frag).
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // Construtor: busca e compila os shaders pelo nome do arquivo em res/shaders.
+    // vertexName: nome do vertex shader (ex: "snakeVertex.vert").
+    // fragmentName: nome do fragment shader (ex: "snakeColor.frag").
+    // O código vem da cópia embutida no executável (veja ShaderSources.h).
+    Shader(const char* vertexName, const char* fragmentName);
+    // Construtor: compila um código já lido, com os nomes usados só nas mensagens de erro
+    // e em 'usesFile'. Usado para recarregar os shaders durante o jogo.
+    Shader(const char* vertexName, const char* fragmentName,
+           const std::string& vertexCode, const std::string& fragmentCode);
+    // Destrutor: libera o programa na GPU.
+    ~Shader();
+
+    // O objeto é dono do programa na GPU, então não pode ser copiado.
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    // Retorna falso se a compilação ou a linkagem falhou (o programa não desenha nada).
+    bool isLinked() const { return linked; }
+    // Retorna verdadeiro se o arquivo 'name' é o vertex ou o fragment shader deste programa.
+    bool usesFile(const std::string& name) const { return name == vertexName || name == fragmentName; }
+    // Nomes e código-fonte dos dois shaders.
+    const std::string& getVertexName() const { return vertexName; }
+    const std::string& getFragmentName() const { return fragmentName; }
+    const std::string& getVertexCode() const { return vertexCode; }
+    const std::string& getFragmentCode() const { return fragmentCode; }
 
     // Ativa este programa de shader para ser usado nas próximas operações de renderização.
     void use();
 
+    // --- CACHE DE PROGRAMAS ---
+    // Liga o cache em disco de programas já linkados, guardados em 'directory' (criado se
+    // preciso). Os próximos Shaders com o mesmo código, no mesmo driver, são carregados com
+    // 'glProgramBinary' sem compilar GLSL; se o binário estiver velho ou o driver o recusar,
+    // o shader é compilado normalmente e o cache é regravado.
+    // 'loader' busca funções do OpenGL (ex: glfwGetProcAddress) e precisa de um contexto ativo.
+    // Retorna falso (e o cache fica desligado) se o driver não suportar binários de programa.
+    static bool enableBinaryCache(const std::string& directory, GLADloadproc loader);
+
+    // Retorna a localização de um uniform ativo, ou -1 se o programa não o usa.
+    // Não chama o OpenGL: as localizações são lidas uma única vez, logo após a linkagem.
+    // Em arrays, tanto "nome" quanto "nome[0]" levam ao primeiro elemento.
+    int getUniformLocation(const std::string &name) const;
+
     // --- FUNÇÕES 'SETTER' PARA UNIFORMS ---
     // Métodos convenientes para definir os valores de variáveis 'uniform' no shader.
     // Uniforms são variáveis globais no shader que podem ser alteradas pelo código C++.
-    // O 'const' no final indica que esses métodos não alteram o estado do objeto Shader (além do estado do OpenGL).
+    // O 'const' no final indica que esses métodos não alteram o estado visível do objeto Shader.
+    //
+    // Todos agem sobre o programa ativo, então o shader precisa estar em uso ('use()').
+    // Cada setter guarda o último valor enviado e não chama o OpenGL se o valor não mudou.
+    // As versões com 'location' (obtida com 'getUniformLocation') não fazem nenhuma busca
+    // e são as indicadas para o caminho de renderização; as versões com nome buscam a
+    // localização no cache. Uma localização -1 é ignorada, como no próprio OpenGL.
 
     // Define um uniform booleano.
     void setBool(const std::string &name, bool value) const;
     // Define um uniform inteiro.
     void setInt(const std::string &name, int value) const;
+    void setInt(int location, int value) const;
     // Define um uniform de ponto flutuante.
     void setFloat(const std::string &name, float value) const;
+    void setFloat(int location, float value) const;
+    // Define uniforms de vetores de 2, 3 e 4 floats.
+    void setVec2(const std::string &name, const glm::vec2 &value) const;
+    void setVec2(int location, const glm::vec2 &value) const;
+    void setVec3(const std::string &name, const glm::vec3 &value) const;
+    void setVec3(int location, const glm::vec3 &value) const;
+    void setVec4(const std::string &name, const glm::vec4 &value) const;
+    void setVec4(int location, const glm::vec4 &value) const;
+    // Define um uniform de matriz 4x4.
+    void setMat4(const std::string &name, const glm::mat4 &value) const;
+    void setMat4(int location, const glm::mat4 &value) const;
     
   private:
+    // Último valor enviado a uma localização (até 16 floats, o tamanho de uma mat4).
+    // Inteiros são guardados com os mesmos bits em 'data'.
+    struct UniformValue {
+        bool valid;      // Falso até o primeiro envio.
+        float data[16];  // Componentes do último valor.
+    };
+
+    // Lê os uniforms ativos do programa linkado ('GL_ACTIVE_UNIFORMS') e preenche o cache.
+    void cacheUniforms();
+    // Carrega o programa do cache em disco ('ID' fica 0 em caso de falha).
+    bool loadProgramBinary(uint64_t key);
+    // Grava o programa linkado no cache em disco.
+    void saveProgramBinary(uint64_t key);
+    // Retorna verdadeiro (e atualiza o cache) se 'count' floats de 'value' diferem do que
+    // foi enviado por último para 'location'. Localizações inválidas retornam falso.
+    bool changed(int location, const float* value, int count) const;
+
+    std::unordered_map<std::string, int> locations; // Localização de cada uniform ativo, pelo nome.
+    mutable std::vector<UniformValue> values;        // Último valor de cada localização.
+
     // Método auxiliar privado para verificar erros de compilação ou de "linkagem" (linking) dos shaders.
     // shader: o ID do shader ou do programa.
     // type: uma string que descreve o que está sendo verificado ("VERTEX", "FRAGMENT", ou "PROGRAM").
-    void checkCompileErrors(unsigned int shader, std::string type);
+    // Retorna verdadeiro se não houve erro.
+    bool checkCompileErrors(unsigned int shader, std::string type);
+    // Compila e linka 'vertexCode' e 'fragmentCode' (ou carrega o programa do cache).
+    void build();
+
+    std::string vertexName;    // Nome do arquivo do vertex shader.
+    std::string fragmentName;  // Nome do arquivo do fragment shader.
+    std::string vertexCode;    // Código do vertex shader (guardado para recargas parciais).
+    std::string fragmentCode;  // Código do fragment shader.
+    bool linked;               // Verdadeiro se o programa pode ser usado.
 };
 
 #endif
\ No newline at end of file
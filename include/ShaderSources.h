@@ -0,0 +1,22 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef SHADER_SOURCES_H
+#define SHADER_SOURCES_H
+
+// Inclui a biblioteca de strings da STL.
+#include <string>
+
+// Código-fonte dos shaders do jogo.
+// Todos os arquivos de res/shaders são embutidos no executável durante a compilação
+// (veja cmake/EmbedShaders.cmake), então o jogo não lê nenhum arquivo ao iniciar e roda
+// a partir de qualquer diretório. Para desenvolver os shaders sem recompilar, a variável
+// de ambiente SNAKE_SHADER_DIR aponta para um diretório cujos arquivos têm prioridade
+// sobre os embutidos (ex: SNAKE_SHADER_DIR=res/shaders).
+
+// Coloca em 'source' o código do shader 'name' (ex: "snakeColor.frag"), lido do diretório
+// de SNAKE_SHADER_DIR, se houver, ou da cópia embutida. Retorna falso se não existir.
+bool loadShaderSource(const std::string& name, std::string& source);
+
+// Diretório de SNAKE_SHADER_DIR, ou vazio se a variável não estiver definida.
+std::string shaderOverrideDirectory();
+
+#endif
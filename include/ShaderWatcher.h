@@ -0,0 +1,53 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef SHADER_WATCHER_H
+#define SHADER_WATCHER_H
+
+// Inclui strings, mapas, threads e as primitivas de sincronização da STL.
+#include <string>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+// Observa um diretório de shaders em uma thread separada e lê os arquivos alterados,
+// para que o jogo possa recarregar os shaders sem reiniciar.
+// A thread dorme em 'poll' até o inotify avisar que um arquivo foi gravado; então lê o
+// arquivo inteiro e o deixa em 'pending'. A thread de renderização só precisa chamar
+// 'takeChanges' entre dois frames: a leitura do disco nunca acontece durante um frame.
+// Disponível apenas no Linux (inotify); nos outros sistemas 'start' retorna falso.
+class ShaderWatcher {
+public:
+    ShaderWatcher();
+    // Destrutor: para a thread, se estiver rodando.
+    ~ShaderWatcher();
+
+    // A thread e os descritores de arquivo não podem ser copiados.
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    // Começa a observar os arquivos .vert e .frag de 'directory'.
+    // Retorna falso se o diretório não puder ser observado.
+    bool start(const std::string& directory);
+    // Para a thread e espera que ela termine.
+    void stop();
+
+    // Retorna verdadeiro se há arquivos alterados esperando por 'takeChanges'.
+    // É só uma leitura atômica, barata o bastante para ser feita a cada frame.
+    bool hasChanges() const { return changed.load(std::memory_order_acquire); }
+    // Entrega o código dos arquivos alterados desde a última chamada (nome -> código).
+    std::map<std::string, std::string> takeChanges();
+
+private:
+    // Laço da thread: espera eventos do inotify e lê os arquivos alterados.
+    void run();
+
+    std::string directory;                        // Diretório observado.
+    std::thread thread;                           // Thread de observação.
+    int inotifyFd;                                // Descritor do inotify (-1 se fechado).
+    int stopPipe[2];                              // Pipe usado para acordar a thread ao parar.
+    std::mutex mutex;                             // Protege 'pending'.
+    std::map<std::string, std::string> pending;   // Arquivos lidos e ainda não entregues.
+    std::atomic<bool> changed;                    // Verdadeiro se 'pending' não está vazio.
+};
+
+#endif
@@ -0,0 +1,64 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Inclui a definição da classe Snake (e de GridPosition e Direction).
+// Este módulo contém apenas as regras do jogo: não depende de GLFW, GLAD ou OpenGL,
+// então pode rodar em servidores sem tela (treinamento de bots, benchmarks, etc.).
+#include "Snake.h"
+// Inclui o gerador de números aleatórios de cada partida.
+#include "Random.h"
+#include <cstdint>
+
+// Ação que o jogador (ou um bot) pode tomar em um passo da simulação.
+// NONE mantém a direção atual; as demais pedem uma mudança de direção.
+enum class Action {
+    NONE,
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT
+};
+
+// Estado completo de uma partida: dimensões do grid, cobra, comida e gerador aleatório.
+struct GameState {
+    // Construtor: cria uma partida nova em um grid de 'gridWidth' x 'gridHeight' células.
+    // A mesma semente produz exatamente a mesma sequência de comidas.
+    GameState(int gridWidth, int gridHeight, uint64_t seed);
+
+    const int gridWidth;  // Largura do grid (em células).
+    const int gridHeight; // Altura do grid (em células).
+    Snake snake;          // A cobra controlada pelo jogador.
+    GridPosition food;    // Posição da comida no grid.
+    Random rng;           // Gerador usado para sortear a comida desta partida.
+
+    // A pontuação é o número de frutas comidas, ou seja, o tamanho da cobra menos a cabeça.
+    int getScore() const { return (int)snake.getBody().size() - 1; }
+};
+
+// Resultado de um passo da simulação.
+struct StepResult {
+    bool ateFood;  // A cobra comeu a comida neste passo.
+    bool gameOver; // A cobra saiu do grid ou bateu em si mesma.
+    bool won;      // A cobra ocupou todas as células do grid.
+};
+
+// Avança a partida em um passo: aplica a ação, move a cobra, verifica colisões e,
+// se a cobra comeu, sorteia uma nova comida. Não lê nem escreve nada fora de 'state'
+// (sem janela, sem entrada, sem saída no console, sem estado global), então partidas
+// diferentes podem rodar em threads diferentes.
+// Quando 'gameOver' ou 'won' são verdadeiros, cabe ao chamador reiniciar a partida.
+StepResult step(GameState& state, Action action);
+
+// Reinicia a partida: cobra na posição inicial e uma nova comida.
+void resetGame(GameState& state);
+
+// Volta a partida exatamente ao estado criado pelo construtor com a semente 'seed'
+// (cobra e comida iniciais, gerador no início da sequência).
+void restartGame(GameState& state, uint64_t seed);
+
+// Sorteia uma posição para a comida que não esteja sobre a cobra, usando o gerador
+// da partida. O grid não pode estar cheio.
+GridPosition generateNewFood(GameState& state);
+
+#endif
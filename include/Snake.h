@@ -2,22 +2,12 @@
 #ifndef SNAKE_H
 #define SNAKE_H
 
-// Inclui a biblioteca de vetores da STL para armazenar o corpo da cobra.
-#include <vector>
-
-// Estrutura para representar uma posição (x, y) no grid.
-// É mais simples que uma classe e serve bem para agrupar dados.
-struct GridPosition {
-    int x; // Coordenada X
-    int y; // Coordenada Y
-
-    // Sobrecarga do operador de igualdade (==).
-    // Permite comparar duas instâncias de GridPosition diretamente (ex: pos1 == pos2).
-    // É 'const' porque não modifica nenhum dos objetos que está comparando.
-    bool operator==(const GridPosition& other) const {
-        return x == other.x && y == other.y;
-    }
-};
+// Inclui o buffer circular usado para armazenar o corpo da cobra,
+// o mapa de ocupação do grid, o conjunto de células livres e a definição de GridPosition.
+#include "RingBuffer.h"
+#include "OccupancyGrid.h"
+#include "FreeCellSet.h"
+#include "GridPosition.h"
 
 // Enumeração de classe para representar as possíveis direções da cobra.
 // Usar 'enum class' é mais seguro em C++ moderno do que 'enum' tradicional,
@@ -33,35 +23,82 @@ enum class Direction {
 class Snake {
 public:
     // Construtor: cria uma cobra com uma posição inicial (cabeça).
-    Snake(int startX, int startY);
+    // 'gridWidth' e 'gridHeight' definem a capacidade máxima do corpo (uma célula por segmento).
+    Snake(int startX, int startY, int gridWidth, int gridHeight);
 
     // Move a cobra na direção atual.
     // O parâmetro 'grow' indica se a cobra deve crescer (ou seja, se comeu uma fruta).
     void move(bool grow);
 
+    // Move a cabeça para 'newHead' (que deve ser vizinha da cabeça atual) sem usar a
+    // direção guardada na cobra. Usado por quem controla as direções por fora, como o BatchSim.
+    void advance(const GridPosition& newHead, bool grow);
+
+    // Reinicia a cobra com uma única célula em (startX, startY), sem realocar memória,
+    // andando na direção 'direction'.
+    void reset(int startX, int startY, Direction direction = Direction::RIGHT);
+    // Como 'reset', mas também devolve as células livres à ordem do construtor, então a
+    // cobra fica idêntica a uma recém-criada (inclusive nas comidas que serão sorteadas).
+    void restart(int startX, int startY, Direction direction = Direction::RIGHT);
+
     // Altera a próxima direção da cobra, com lógica para evitar que ela se inverta.
     void changeDirection(Direction newDirection);
+    // Verifica se duas direções são opostas (ex: UP e DOWN).
+    static bool isOpposite(Direction a, Direction b);
     
     // Verifica se a cabeça da cobra está fora dos limites do grid.
-    bool isOutOfBounds(int gridWidth, int gridHeight) const;
+    bool isOutOfBounds() const;
     // Verifica se a cabeça da cobra colidiu com qualquer outra parte de seu corpo.
-    bool isSelfCollision() const;
+    // O resultado é calculado em O(1) durante o último 'move', pelo mapa de ocupação.
+    bool isSelfCollision() const { return selfCollision; }
+    // Verifica se uma célula do grid está ocupada por algum segmento da cobra, em O(1).
+    // Posições fora do grid são consideradas livres.
+    bool isOccupied(const GridPosition& position) const
+    {
+        return occupancy.contains(position) && occupancy.test(position);
+    }
+
+    // Número de células do grid que não estão ocupadas pela cobra.
+    // Quando chega a zero, a cobra preencheu o grid inteiro (vitória).
+    size_t getFreeCellCount() const { return freeCells.size(); }
+    bool isBoardFull() const { return freeCells.empty(); }
+    // Retorna a i-ésima célula livre, com i em [0, getFreeCellCount()).
+    // Sortear 'i' uniformemente dá uma célula livre uniforme em O(1).
+    GridPosition getFreeCell(size_t i) const { return freeCells.at(i); }
+    // Acesso ao conjunto de células livres, cuja ordem influencia o sorteio da comida.
+    const FreeCellSet& getFreeCells() const { return freeCells; }
+    // Restaura a ordem das células livres (veja FreeCellSet::reorder).
+    void setFreeCellOrder(const uint32_t* order, size_t count) { freeCells.reorder(order, count); }
 
     // --- MÉTODOS DE ACESSO (GETTERS) ---
     // São 'const' porque apenas retornam dados e não modificam o estado do objeto Snake.
 
     // Retorna a posição da cabeça da cobra.
     GridPosition getHead() const;
-    // Retorna uma referência constante ao vetor que representa o corpo da cobra.
+    // Retorna uma referência constante ao buffer que representa o corpo da cobra.
     // A referência é mais eficiente que uma cópia, e 'const' garante que o corpo não seja modificado externamente.
-    const std::vector<GridPosition>& getBody() const { return body; }
+    // O buffer é percorrido da cabeça (índice 0) até o rabo.
+    const RingBuffer<GridPosition>& getBody() const { return body; }
+    // Retorna a posição que o rabo ocupava antes do último movimento.
+    // Se a cobra cresceu, é a própria posição atual do rabo. Junto com 'body[i + 1]'
+    // (a posição anterior do segmento 'i'), permite interpolar o desenho entre dois passos.
+    GridPosition getPreviousTail() const { return previousTail; }
     // Retorna a direção atual da cobra.
     Direction getCurrentDirection() const { return currentDirection; }
 
 private:
-    // Vetor de posições que armazena os segmentos do corpo da cobra.
-    // O primeiro elemento (body[0]) é a cabeça.
-    std::vector<GridPosition> body;
+    // Buffer circular que armazena os segmentos do corpo da cobra.
+    // O primeiro elemento (body[0]) é a cabeça. A capacidade é o número de células do grid,
+    // então mover a cobra nunca realoca nem desloca memória.
+    RingBuffer<GridPosition> body;
+    // Mapa de bits com as células ocupadas pelo corpo, atualizado a cada 'move'.
+    OccupancyGrid occupancy;
+    // Conjunto denso das células livres, atualizado junto com o mapa de ocupação.
+    FreeCellSet freeCells;
+    // Indica se a cabeça entrou em uma célula já ocupada no último movimento.
+    bool selfCollision;
+    // Posição do rabo antes do último movimento (veja 'getPreviousTail').
+    GridPosition previousTail;
     // A direção em que a cobra está se movendo atualmente.
     Direction currentDirection;
     // A próxima direção que a cobra tomará. Usado para registrar a entrada do jogador
@@ -0,0 +1,70 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef SWEEP_PATH_H
+#define SWEEP_PATH_H
+
+// Inclui a definição de Action (e de GridPosition).
+#include "Simulation.h"
+
+// --- CICLO EM ZIGUE-ZAGUE ---
+// Um caminho fechado que passa uma vez por cada célula do grid. Uma cobra que o segue
+// nunca sai do grid nem bate em si mesma, e pode crescer até ocupar o grid inteiro; por
+// isso é usado pelos benchmarks para jogar partidas longas e montar cobras de qualquer tamanho.
+// Com os dois lados ímpares não existe um ciclo assim: o grid precisa de um lado par.
+
+// Direção do ciclo a partir de (x, y), em um grid de altura par (Y aumenta para cima).
+// As linhas são percorridas da coluna 1 até a última e de volta, alternadamente, subindo
+// uma linha no fim de cada uma; a coluna 0 é o caminho de volta da última linha até a primeira.
+inline Action sweepRowAction(int x, int y, int width, int height)
+{
+    if (x == 0)
+    {
+        return y == 0 ? Action::RIGHT : Action::DOWN;
+    }
+    if (y % 2 == 0)
+    {
+        return x < width - 1 ? Action::RIGHT : Action::UP;
+    }
+    if (x > 1)
+    {
+        return Action::LEFT;
+    }
+    return y == height - 1 ? Action::LEFT : Action::UP;
+}
+
+// Troca os eixos de uma ação (usado quando só a largura é par e o grid é percorrido
+// por colunas em vez de linhas).
+inline Action transposeAction(Action action)
+{
+    switch (action)
+    {
+    case Action::UP:
+        return Action::RIGHT;
+    case Action::DOWN:
+        return Action::LEFT;
+    case Action::LEFT:
+        return Action::DOWN;
+    case Action::RIGHT:
+        return Action::UP;
+    default:
+        return Action::NONE;
+    }
+}
+
+// Verdadeiro se o grid tem o ciclo (largura ou altura par).
+inline bool hasSweepPath(int width, int height)
+{
+    return width % 2 == 0 || height % 2 == 0;
+}
+
+// Próxima ação do ciclo para a cabeça em 'head'. Se a altura for ímpar, o grid é
+// percorrido por colunas.
+inline Action sweepAction(const GridPosition& head, int width, int height)
+{
+    if (height % 2 != 0)
+    {
+        return transposeAction(sweepRowAction(head.y, head.x, height, width));
+    }
+    return sweepRowAction(head.x, head.y, width, height);
+}
+
+#endif
@@ -0,0 +1,73 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef TRACING_H
+#define TRACING_H
+
+// Inclui strings e os tipos inteiros de tamanho fixo.
+#include <string>
+#include <cstdint>
+
+// --- TRACE DAS FASES DO JOGO ---
+// Grava o início e a duração de cada fase marcada com SNAKE_TRACE_SCOPE, em qual thread ela
+// rodou, e escreve tudo no fim em um arquivo JSON no formato 'trace_event' do Chrome, que
+// pode ser aberto no Perfetto (ui.perfetto.dev) ou em chrome://tracing.
+//
+// Cada thread grava em um buffer só dela, em blocos de eventos alocados conforme a
+// necessidade, sem travas (só o registro da thread, no seu primeiro evento, usa uma trava).
+// Com o trace desligado, uma fase marcada custa a leitura de um 'bool' atômico.
+// Compilado apenas com SNAKE_TRACING; ligado em tempo de execução por 'beginTracing'.
+
+#ifdef SNAKE_TRACING
+
+// Liga o trace. Os eventos serão escritos em 'path' por 'finishTracing'.
+void beginTracing(const std::string& path);
+// Verdadeiro enquanto o trace está ligado.
+bool isTracing();
+// Desliga o trace e escreve o arquivo JSON. Deve ser chamado depois que as outras threads
+// que gravaram eventos terminaram. Retorna falso se o arquivo não pôde ser escrito.
+bool finishTracing();
+// Dá um nome à thread atual no trace (ex: "render", "simulacao").
+void setTraceThreadName(const char* name);
+
+// Instante atual, em nanossegundos desde 'beginTracing'.
+uint64_t traceNow();
+// Grava uma fase de 'duration' ns que começou em 'start'. 'name' deve ser uma string que
+// dure até 'finishTracing' (na prática, um literal).
+void recordTraceEvent(const char* name, uint64_t start, uint64_t duration);
+
+// Grava o tempo de vida do objeto como uma fase, se o trace estiver ligado na criação.
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name(name), active(isTracing()), start(active ? traceNow() : 0) {}
+    ~TraceScope()
+    {
+        if (active)
+        {
+            recordTraceEvent(name, start, traceNow() - start);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    bool active;
+    uint64_t start;
+};
+
+// Grava o restante do bloco atual como a fase 'name' (ex: SNAKE_TRACE_SCOPE("render")).
+#define SNAKE_TRACE_SCOPE_CONCAT2(a, b) a##b
+#define SNAKE_TRACE_SCOPE_CONCAT(a, b) SNAKE_TRACE_SCOPE_CONCAT2(a, b)
+#define SNAKE_TRACE_SCOPE(name) TraceScope SNAKE_TRACE_SCOPE_CONCAT(traceScope, __LINE__)(name)
+#define SNAKE_TRACE_THREAD(name) setTraceThreadName(name)
+
+#else
+
+// Sem SNAKE_TRACING, as marcações desaparecem do código compilado.
+#define SNAKE_TRACE_SCOPE(name) ((void)0)
+#define SNAKE_TRACE_THREAD(name) ((void)0)
+
+#endif
+
+#endif
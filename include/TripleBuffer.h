@@ -0,0 +1,59 @@
+// Impede que o cabeçalho seja incluído várias vezes em uma mesma compilação.
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+// Inclui as operações atômicas e os tipos inteiros de tamanho fixo.
+#include <atomic>
+#include <cstdint>
+
+// Buffer triplo sem travas entre uma thread que escreve e uma que lê.
+// Há três cópias de 'T': a do escritor ('back'), a do leitor ('front') e uma do meio.
+// Publicar troca a cópia do escritor pela do meio, e consumir troca a do meio pela do
+// leitor, cada troca com uma única operação atômica. Nenhum lado espera pelo outro: o
+// escritor sempre tem uma cópia livre para preencher, e o leitor sempre vê a publicação
+// mais recente inteira (as intermediárias que ele não chegou a ler são descartadas).
+// As cópias são reaproveitadas, então um 'T' com vetores não aloca memória depois que
+// as capacidades se estabilizam.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), middle(1), front(2) {}
+
+    // --- LADO DO ESCRITOR ---
+    // Cópia a ser preenchida antes de 'publish'. Contém uma publicação antiga, não zerada.
+    T& writeBuffer() { return slots[back]; }
+    // Entrega a cópia preenchida ao leitor e pega a do meio para a próxima escrita.
+    void publish()
+    {
+        uint8_t previous = middle.exchange((uint8_t)(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // --- LADO DO LEITOR ---
+    // Troca a cópia do leitor pela publicação mais recente, se houver uma nova.
+    // Retorna falso (e mantém a cópia atual) se nada foi publicado desde a última troca.
+    bool consume()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+        {
+            return false;
+        }
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    // Publicação lida no último 'consume'.
+    const T& readBuffer() const { return slots[front]; }
+
+private:
+    // O índice da cópia do meio divide o byte com um bit que diz se ela é nova.
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T slots[3];
+    uint8_t back;                 // Cópia do escritor (só o escritor usa).
+    std::atomic<uint8_t> middle;  // Cópia do meio, trocada pelos dois lados.
+    uint8_t front;                // Cópia do leitor (só o leitor usa).
+};
+
+#endif
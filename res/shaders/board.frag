@@ -0,0 +1,25 @@
+// Fragment shader do modo de tabuleiro em textura: a cor de cada pixel vem do código
+// da célula sob ele, lido da textura do tabuleiro (veja BoardTexture.h).
+#version 330 core
+
+out vec4 FragColor;
+
+// Posição do fragmento no grid (em células), vinda de 'grid.vert'.
+in vec2 vGridPos;
+
+// --- UNIFORMS ---
+uniform usampler2D board;  // Um código por célula: 0 vazia, 1 corpo, 2 cabeça, 3 comida.
+uniform vec2 gridSize;     // Largura e altura do grid (em células).
+uniform vec4 palette[4];   // Cor de cada código.
+
+void main()
+{
+  // Fora do tabuleiro não há nada a desenhar.
+  if (any(lessThan(vGridPos, vec2(0.0))) || any(greaterThanEqual(vGridPos, gridSize)))
+  {
+    discard;
+  }
+
+  uint cell = texelFetch(board, ivec2(floor(vGridPos)), 0).r;
+  FragColor = palette[min(cell, 3u)];
+}
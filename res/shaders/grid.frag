@@ -0,0 +1,41 @@
+// Fragment shader do grid procedural: as linhas são calculadas por pixel, sem geometria.
+#version 330 core
+
+out vec4 FragColor;
+
+// Posição do fragmento no grid (em células), vinda do vertex shader.
+in vec2 vGridPos;
+
+// --- UNIFORMS ---
+uniform vec2 gridSize;    // Largura e altura do grid (em células).
+uniform vec4 lineColor;   // Cor das linhas.
+uniform float lineWidth;  // Espessura das linhas, em pixels.
+
+void main()
+{
+  // Fora do tabuleiro não há linhas.
+  if (any(lessThan(vGridPos, vec2(0.0))) || any(greaterThan(vGridPos, gridSize)))
+  {
+    discard;
+  }
+
+  // 'fwidth' diz quantas células cabem em um pixel, em cada eixo. Dividindo a distância
+  // até a borda de célula mais próxima por esse valor, obtemos a distância em pixels.
+  vec2 cellsPerPixel = fwidth(vGridPos);
+  vec2 distanceToLine = abs(fract(vGridPos + 0.5) - 0.5) / cellsPerPixel;
+  float distanceInPixels = min(distanceToLine.x, distanceToLine.y);
+
+  // Antisserrilhamento: a cobertura cai de 1 a 0 ao longo de um pixel na borda da linha.
+  float coverage = 1.0 - clamp(distanceInPixels - 0.5 * lineWidth + 0.5, 0.0, 1.0);
+
+  // Em tabuleiros enormes, as células ficam com poucos pixels e as linhas cobririam tudo;
+  // elas desaparecem gradualmente quando uma célula tem menos de 6 pixels.
+  float pixelsPerCell = 1.0 / max(cellsPerPixel.x, cellsPerPixel.y);
+  coverage *= smoothstep(2.0, 6.0, pixelsPerCell);
+
+  if (coverage <= 0.0)
+  {
+    discard;
+  }
+  FragColor = vec4(lineColor.rgb, lineColor.a * coverage);
+}
@@ -0,0 +1,17 @@
+// Vertex shader do grid procedural: um único triângulo que cobre a tela inteira.
+#version 330 core
+
+// Inversa da matriz de projeção, que leva as coordenadas de clipe de volta ao grid.
+uniform mat4 inverseProjection;
+
+// Posição no grid (em células) de cada fragmento, interpolada pela rasterização.
+out vec2 vGridPos;
+
+void main()
+{
+  // Não há VBO: os três vértices saem de 'gl_VertexID' (0, 1, 2) e formam um triângulo
+  // com cantos em (-1, -1), (3, -1) e (-1, 3), que cobre todo o quadrado de clipe [-1, 1].
+  vec2 clip = vec2(float((gl_VertexID & 1) << 2) - 1.0, float((gl_VertexID & 2) << 1) - 1.0);
+  gl_Position = vec4(clip, 0.0, 1.0);
+  vGridPos = (inverseProjection * vec4(clip, 0.0, 1.0)).xy;
+}
@@ -10,17 +10,23 @@ out vec4 FragColor;
 // --- VARIÁVEL GLOBAL (UNIFORM) ---
 // Declara um uniform que receberá a cor do objeto do nosso programa C++.
 // Como é um uniform, todos os fragmentos de uma mesma chamada de desenho terão a mesma cor.
-// Isso é perfeito para o nosso jogo, onde cada parte (segmento da cobra, comida, linha do grid)
-// tem uma cor sólida única.
+// O jogo o deixa branco no desenho instanciado da cobra e da comida; o SnakeMicroBenchGL
+// o usa para dar a cor de cada quadrado que desenha sozinho (com 'snakeVertex.vert').
 uniform vec4 objectColor;
 
+// --- ENTRADA DO VERTEX SHADER ---
+// Cor do vértice (a cor de cada instância em 'snakeSegments.vert'; branca em 'snakeVertex.vert').
+in vec4 vColor;
+
 // A função 'main' é o ponto de entrada do fragment shader.
 // Ela é executada para cada fragmento (pixel potencial) gerado pela rasterização
 // das primitivas (triângulos, linhas, etc.).
 void main()
 {
   // A tarefa do fragment shader é determinar a cor de cada fragmento.
-  // Neste caso, a lógica é muito simples: apenas atribuímos a cor recebida
-  // do uniform 'objectColor' diretamente à variável de saída 'FragColor'.
-  FragColor = objectColor;
+  // Neste caso, a lógica é muito simples: a cor do uniform 'objectColor' multiplicada
+  // pela cor do vértice. Na cobra e na comida o uniform é branco e a cor vem da
+  // instância; nos quadrados avulsos do microbenchmark a cor do vértice é branca e a
+  // cor vem do uniform. (O grid tem o seu próprio shader, 'grid.frag'.)
+  FragColor = objectColor * vColor;
 }
\ No newline at end of file
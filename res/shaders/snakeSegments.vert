@@ -0,0 +1,66 @@
+// Vertex shader da cobra e da comida, desenhadas com uma única chamada instanciada.
+#version 330 core
+
+// --- ENTRADA DE VÉRTICE (ATRIBUTO) ---
+// Os 6 vértices do quadrado centrado em (0, 0), os mesmos de 'snakeVertex.vert'.
+layout (location = 0) in vec3 aPos;
+
+// --- SEGMENTOS DA COBRA ---
+// As células do corpo ficam em uma textura de buffer organizada como o buffer circular
+// do corpo na CPU: o segmento 'i' (0 = cabeça) está na posição '(headSlot + i) % capacity'.
+// Assim, a cada passo a CPU só precisa enviar a célula da nova cabeça.
+uniform isamplerBuffer segments;
+uniform int headSlot;      // Posição física da cabeça no anel.
+uniform int capacity;      // Número de posições do anel.
+uniform int segmentCount;  // Tamanho atual da cobra.
+
+// --- INTERPOLAÇÃO ---
+// Cada segmento é desenhado entre a posição do passo anterior e a atual. A posição anterior
+// do segmento 'i' é a atual do segmento 'i + 1'; para o rabo, é 'previousTail'.
+uniform vec2 previousTail;
+uniform float alpha;       // Fração do intervalo entre dois passos (de 0 a 1).
+
+// --- COMIDA ---
+// A instância 0 é a comida; o segmento 'i' é a instância 'i + 1'. A comida vem primeiro
+// para que a cobra seja desenhada por cima dela (a cabeça passa sobre a comida antes de comê-la).
+uniform vec2 food;
+
+// --- CORES E PROJEÇÃO ---
+uniform vec4 snakeColor;
+uniform vec4 foodColor;
+uniform mat4 projection;
+
+// Cor do quadrado, repassada ao fragment shader.
+out vec4 vColor;
+
+// Lê a célula do segmento 'i' no anel.
+vec2 segment(int i)
+{
+  int slot = headSlot + i;
+  if (slot >= capacity)
+  {
+    slot -= capacity;
+  }
+  return vec2(texelFetch(segments, slot).xy);
+}
+
+void main()
+{
+  vec2 position;
+  if (gl_InstanceID == 0)
+  {
+    position = food;
+    vColor = foodColor;
+  }
+  else
+  {
+    int i = gl_InstanceID - 1;
+    vec2 to = segment(i);
+    vec2 from = (i + 1 < segmentCount) ? segment(i + 1) : previousTail;
+    position = mix(from, to, alpha);
+    vColor = snakeColor;
+  }
+
+  // Soma 0.5 para centralizar o quadrado dentro da célula do grid.
+  gl_Position = projection * vec4(aPos.xy + position + vec2(0.5), aPos.z, 1.0);
+}
@@ -11,6 +11,11 @@
 // Ela receberá a posição de cada vértice do nosso VBO (Vertex Buffer Object).
 layout (location = 0) in vec3 aPos;
 
+// --- SAÍDA PARA O FRAGMENT SHADER ---
+// Cor do vértice, multiplicada pelo uniform 'objectColor' no fragment shader. Aqui é sempre
+// branca (a cor vem só do uniform); 'snakeSegments.vert' a usa para colorir cada instância.
+out vec4 vColor;
+
 // --- VARIÁVEIS GLOBAIS (UNIFORMS) ---
 // Uniforms são variáveis globais que têm o mesmo valor para todos os vértices
 // processados por uma única chamada de desenho. Elas são definidas pelo nosso programa C++.
@@ -37,4 +42,5 @@ void main()
   // 3. 'projection * ...': Aplica a matriz de projeção. Isso transforma o vértice do espaço do mundo
   //    para o espaço de clipe, que é o que o OpenGL usa para mapear tudo para a tela.
   gl_Position = projection * model * vec4(aPos, 1.0);
+  vColor = vec4(1.0);
 }
\ No newline at end of file
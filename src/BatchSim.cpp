@@ -0,0 +1,135 @@
+// Inclui o cabeçalho do simulador em lote.
+#include "BatchSim.h"
+
+// --- FASE VETORIZADA ---
+// Aplica as ações, move as cabeças e testa comida e limites de todas as partidas.
+// Sem desvios nem acessos indiretos: cada iteração só lê e escreve o elemento 'i'
+// dos arrays, o que permite ao compilador processar várias partidas por instrução.
+// Os parâmetros '__restrict' garantem ao compilador que os arrays não se sobrepõem,
+// dispensando testes de sobreposição em tempo de execução.
+static void moveHeads(size_t n, unsigned width, unsigned height,
+                      const Action* __restrict act,
+                      int32_t* __restrict hx, int32_t* __restrict hy, int32_t* __restrict dir,
+                      const int32_t* __restrict fx, const int32_t* __restrict fy,
+                      uint8_t* __restrict ate, uint8_t* __restrict out)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Ação em direção: NONE=0, UP=1, DOWN=2, LEFT=3, RIGHT=4 -> Direction = ação - 1.
+        // Direções opostas diferem só no último bit (UP^1 = DOWN, LEFT^1 = RIGHT),
+        // então a inversão é descartada com um XOR.
+        int32_t action = (int32_t)act[i];
+        int32_t wanted = action - 1;
+        int32_t d = dir[i];
+        d = ((action != 0) & ((wanted ^ 1) != d)) ? wanted : d;
+        dir[i] = d;
+
+        // A comida é testada com a cabeça antes do movimento, como em 'step'.
+        ate[i] = (uint8_t)((hx[i] == fx[i]) & (hy[i] == fy[i]));
+
+        // Deslocamento da cabeça: RIGHT soma 1 em X, LEFT subtrai; UP soma 1 em Y, DOWN subtrai.
+        int32_t nx = hx[i] + (int32_t)(d == (int32_t)Direction::RIGHT) - (int32_t)(d == (int32_t)Direction::LEFT);
+        int32_t ny = hy[i] + (int32_t)(d == (int32_t)Direction::UP) - (int32_t)(d == (int32_t)Direction::DOWN);
+        hx[i] = nx;
+        hy[i] = ny;
+
+        // Teste de limites com uma comparação sem sinal por eixo.
+        // Os operadores '&' e '|' (em vez de '&&' e '||') evitam desvios no laço.
+        out[i] = (uint8_t)(((unsigned)nx >= width) | ((unsigned)ny >= height));
+    }
+}
+
+// --- CONSTRUTOR ---
+// Cria todas as partidas no estado inicial de 'GameState'.
+BatchSim::BatchSim(size_t numEnvs, int gridWidth, int gridHeight, uint64_t seed)
+    : gridWidth(gridWidth), gridHeight(gridHeight),
+      headX(numEnvs), headY(numEnvs), direction(numEnvs), length(numEnvs),
+      foodX(numEnvs), foodY(numEnvs),
+      ateFood(numEnvs, 0), outOfBounds(numEnvs, 0), done(numEnvs, 0), finalScore(numEnvs, 0),
+      snakes(numEnvs, Snake(gridWidth / 4, gridHeight / 2, gridWidth, gridHeight))
+{
+    rngs.reserve(numEnvs);
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+        rngs.emplace_back(seed, i);
+        resetEnv(i);
+    }
+}
+
+// --- PASSO DE TODAS AS PARTIDAS ---
+// Segue as mesmas regras de 'step' (Simulation.cpp), dividido em três fases.
+void BatchSim::step(const Action* actions)
+{
+    const size_t n = snakes.size();
+
+    // 1. --- FASE VETORIZADA ---
+    moveHeads(n, (unsigned)gridWidth, (unsigned)gridHeight, actions,
+              headX.data(), headY.data(), direction.data(),
+              foodX.data(), foodY.data(), ateFood.data(), outOfBounds.data());
+
+    int32_t* hx = headX.data();
+    int32_t* hy = headY.data();
+    uint8_t* ate = ateFood.data();
+    uint8_t* out = outOfBounds.data();
+
+    // 2. --- FASE ESCALAR: CORPOS ---
+    // Atualiza o buffer circular e o mapa de ocupação de cada cobra (acessos indiretos
+    // à memória, que não se beneficiam de SIMD) e decide quem terminou a partida.
+    for (size_t i = 0; i < n; ++i)
+    {
+        done[i] = out[i];
+        if (out[i])
+        {
+            finalScore[i] = length[i] - 1;
+            continue;
+        }
+
+        Snake& snake = snakes[i];
+        snake.advance({hx[i], hy[i]}, ate[i] != 0);
+        length[i] = (int32_t)snake.getBody().size();
+
+        if (snake.isSelfCollision() || snake.isBoardFull())
+        {
+            done[i] = 1;
+            finalScore[i] = length[i] - 1;
+        }
+        else if (ate[i])
+        {
+            placeFood(i);
+        }
+    }
+
+    // 3. --- REINÍCIO NO LUGAR ---
+    // Partidas terminadas voltam ao estado inicial para o próximo passo.
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (done[i])
+        {
+            resetEnv(i);
+        }
+    }
+}
+
+// --- REINICIAR UMA PARTIDA ---
+// Equivalente a 'resetGame': cobra no primeiro quarto do grid, indo para a direita.
+void BatchSim::resetEnv(size_t env)
+{
+    int startX = gridWidth / 4;
+    int startY = gridHeight / 2;
+    snakes[env].reset(startX, startY);
+    headX[env] = startX;
+    headY[env] = startY;
+    direction[env] = (int32_t)Direction::RIGHT;
+    length[env] = 1;
+    placeFood(env);
+}
+
+// --- SORTEAR COMIDA ---
+// Escolhe uma célula livre uniformemente, em O(1), pelo conjunto de células livres.
+void BatchSim::placeFood(size_t env)
+{
+    const Snake& snake = snakes[env];
+    GridPosition food = snake.getFreeCell(rngs[env].nextBounded((uint32_t)snake.getFreeCellCount()));
+    foodX[env] = food.x;
+    foodY[env] = food.y;
+}
@@ -0,0 +1,240 @@
+// Ferramenta de linha de comando que mede a velocidade das regras do jogo sem janela:
+// movimento da cobra, colisões e sorteio da comida, passo a passo, na velocidade máxima
+// da CPU. O resultado sai em JSON, para acompanhar regressões entre versões.
+// Uso: ./SnakeBench [--board LxA] [--ticks N] [--policy random|sweep] [--seed S]
+// Ex:  ./SnakeBench --board 4096x4096 --ticks 5000000 --policy sweep
+#include "Simulation.h"
+// Inclui o ciclo em zigue-zague usado pela política 'sweep'.
+#include "SweepPath.h"
+// Inclui o histograma de latências (sempre compilado, mesmo sem SNAKE_INSTRUMENTATION).
+#include "Instrumentation.h"
+// Inclui bibliotecas padrão para entrada/saída, medição de tempo e conversão de texto.
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <iomanip>
+// Inclui a medição do pico de memória do processo, onde existe.
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Política que escolhe a ação de cada passo.
+enum class Policy {
+    RANDOM, // Uma direção aleatória por passo: partidas curtas, muitos reinícios.
+    SWEEP   // Percorre o grid em zigue-zague por um ciclo que passa por todas as células:
+            // a cobra nunca morre e cresce até ocupar o grid inteiro.
+};
+
+// Passos por amostra dos percentis. Ler o relógio custa dezenas de ns, o mesmo que um
+// passo inteiro; medindo blocos de passos, a leitura fica diluída no bloco.
+static const unsigned long long TICKS_PER_SAMPLE = 256;
+
+// Contagem das partidas jogadas.
+struct BenchTotals {
+    unsigned long long games = 0;
+    unsigned long long wins = 0;
+    int bestScore = 0;
+};
+
+// Executa 'count' passos com a política escolhida, reiniciando a partida quando ela acaba.
+// Não lê o relógio: quem chama mede o laço inteiro.
+static void runTicks(GameState& state, Policy policy, Random& actions, unsigned long long count,
+                     BenchTotals& totals)
+{
+    for (unsigned long long t = 0; t < count; ++t)
+    {
+        Action action;
+        if (policy == Policy::RANDOM)
+        {
+            action = (Action)(1 + actions.nextBounded(4));
+        }
+        else
+        {
+            action = sweepAction(state.snake.getHead(), state.gridWidth, state.gridHeight);
+        }
+
+        StepResult result = step(state, action);
+        if (result.gameOver || result.won)
+        {
+            int score = state.getScore();
+            if (score > totals.bestScore)
+            {
+                totals.bestScore = score;
+            }
+            ++totals.games;
+            if (result.won)
+            {
+                ++totals.wins;
+            }
+            resetGame(state);
+        }
+    }
+}
+
+// Custo médio de uma leitura de 'steady_clock::now()', em nanossegundos.
+static double clockReadNanoseconds()
+{
+    const int reads = 100000;
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    for (int i = 0; i < reads; ++i)
+    {
+        last = std::chrono::steady_clock::now();
+    }
+    return std::chrono::duration<double, std::nano>(last - start).count() / reads;
+}
+
+// Pico de memória residente do processo, em KB (-1 se o sistema não informa).
+static long long peakRssKilobytes()
+{
+#if defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (long long)usage.ru_maxrss / 1024; // Em bytes no macOS.
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (long long)usage.ru_maxrss;        // Em KB no Linux.
+#else
+    return -1;
+#endif
+}
+
+int main(int argc, char* argv[])
+{
+    int gridWidth = 20;
+    int gridHeight = 20;
+    unsigned long long ticks = 1000000;
+    Policy policy = Policy::SWEEP;
+    uint64_t seed = 1;
+
+    // --- ARGUMENTOS ---
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--board") == 0 && hasValue)
+        {
+            if (std::sscanf(argv[++i], "%dx%d", &gridWidth, &gridHeight) != 2 || gridWidth < 2 || gridHeight < 2)
+            {
+                std::cerr << "Tamanho de grid inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && hasValue)
+        {
+            std::string name = argv[++i];
+            if (name == "random")
+            {
+                policy = Policy::RANDOM;
+            }
+            else if (name == "sweep")
+            {
+                policy = Policy::SWEEP;
+            }
+            else
+            {
+                std::cerr << "Política desconhecida: " << name << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Uso: " << argv[0]
+                      << " [--board LxA] [--ticks N] [--policy random|sweep] [--seed S]" << std::endl;
+            return 1;
+        }
+    }
+
+    // O ciclo em zigue-zague precisa de um lado par (com os dois lados ímpares não existe
+    // um ciclo que passe por todas as células).
+    if (policy == Policy::SWEEP && !hasSweepPath(gridWidth, gridHeight))
+    {
+        std::cerr << "A política 'sweep' precisa de largura ou altura par." << std::endl;
+        return 1;
+    }
+
+    // --- SIMULAÇÃO ---
+    // Primeira passada: os passos por segundo, medidos no laço inteiro, sem cronômetros dentro.
+    GameState state(gridWidth, gridHeight, seed);
+    // Gerador das ações aleatórias, separado do gerador da comida da partida.
+    Random actions(seed, 1);
+    BenchTotals totals;
+    auto start = std::chrono::steady_clock::now();
+    runTicks(state, policy, actions, ticks, totals);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (state.getScore() > totals.bestScore)
+    {
+        totals.bestScore = state.getScore();
+    }
+
+    // Segunda passada, com a mesma semente (as mesmas partidas): os percentis, medindo
+    // blocos de TICKS_PER_SAMPLE passos e descontando a leitura do relógio de cada bloco.
+    // O histograma guarda o tempo do bloco inteiro (a precisão de 1 ns por passo seria pouca).
+    double clockNanoseconds = clockReadNanoseconds();
+    unsigned long long ticksPerSample = ticks < TICKS_PER_SAMPLE ? ticks : TICKS_PER_SAMPLE;
+    LatencyHistogram sampleTimes;
+    if (ticksPerSample > 0)
+    {
+        GameState sampled(gridWidth, gridHeight, seed);
+        Random sampledActions(seed, 1);
+        BenchTotals sampledTotals;
+        for (unsigned long long s = 0; s < ticks / ticksPerSample; ++s)
+        {
+            auto sampleStart = std::chrono::steady_clock::now();
+            runTicks(sampled, policy, sampledActions, ticksPerSample, sampledTotals);
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - sampleStart).count();
+            sampleTimes.record(elapsed > clockNanoseconds ? (uint64_t)(elapsed - clockNanoseconds) : 0);
+        }
+    }
+    double perTick = ticksPerSample > 0 ? 1.0 / ticksPerSample : 0.0;
+
+    // Sem otimização (ex: CMAKE_BUILD_TYPE=Debug), os números não servem para comparação.
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+    const bool optimized = true;
+#else
+    const bool optimized = false;
+    std::cerr << "Aviso: SnakeBench compilado sem otimização; use CMAKE_BUILD_TYPE=Release." << std::endl;
+#endif
+
+    // --- RESULTADO EM JSON ---
+    // 'ticks_per_second' usa o tempo total da primeira passada. Os percentis são do custo
+    // médio por passo em cada bloco de 'ticks_per_sample' passos (com a escolha da ação),
+    // já sem a leitura do relógio ('clock_ns').
+    std::cout << std::fixed << std::setprecision(3) << "{\n"
+              << "  \"board\": \"" << gridWidth << "x" << gridHeight << "\",\n"
+              << "  \"width\": " << gridWidth << ",\n"
+              << "  \"height\": " << gridHeight << ",\n"
+              << "  \"policy\": \"" << (policy == Policy::RANDOM ? "random" : "sweep") << "\",\n"
+              << "  \"seed\": " << seed << ",\n"
+              << "  \"optimized\": " << (optimized ? "true" : "false") << ",\n"
+              << "  \"ticks\": " << ticks << ",\n"
+              << "  \"games\": " << totals.games << ",\n"
+              << "  \"wins\": " << totals.wins << ",\n"
+              << "  \"best_score\": " << totals.bestScore << ",\n"
+              << "  \"seconds\": " << seconds << ",\n"
+              << "  \"ticks_per_second\": " << (seconds > 0.0 ? ticks / seconds : 0.0) << ",\n"
+              << "  \"clock_ns\": " << clockNanoseconds << ",\n"
+              << "  \"ticks_per_sample\": " << ticksPerSample << ",\n"
+              << "  \"ns_per_tick\": {\n"
+              << "    \"mean\": " << sampleTimes.mean() * perTick << ",\n"
+              << "    \"p50\": " << sampleTimes.percentile(0.50) * perTick << ",\n"
+              << "    \"p90\": " << sampleTimes.percentile(0.90) * perTick << ",\n"
+              << "    \"p99\": " << sampleTimes.percentile(0.99) * perTick << ",\n"
+              << "    \"p99_9\": " << sampleTimes.percentile(0.999) * perTick << ",\n"
+              << "    \"max\": " << sampleTimes.max() * perTick << "\n"
+              << "  },\n"
+              << "  \"peak_rss_kb\": " << peakRssKilobytes() << "\n"
+              << "}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Inclui o cabeçalho da classe BoardTexture.
+#include "BoardTexture.h"
+// Inclui 'std::fill'.
+#include <algorithm>
+
+// --- CONSTRUTOR ---
+BoardTexture::BoardTexture(int width, int height)
+    : texture(0), width(width), height(height),
+      cells((size_t)width * (size_t)height, BOARD_EMPTY),
+      fullUpload(true)
+{
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    // Texturas inteiras não podem ser filtradas: cada texel é lido exatamente com 'texelFetch'.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    // As linhas têm 'width' bytes, que não é necessariamente múltiplo de 4 (o padrão).
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, cells.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// --- DESTRUTOR ---
+BoardTexture::~BoardTexture()
+{
+    glDeleteTextures(1, &texture);
+}
+
+// --- REFAZER ---
+// Custa O(largura * altura), mas só acontece uma vez por partida.
+void BoardTexture::rebuild(const RingBuffer<GridPosition>& body, const GridPosition& food, bool hasFood)
+{
+    std::fill(cells.begin(), cells.end(), (uint8_t)BOARD_EMPTY);
+    // A comida vem primeiro: a cabeça passa um passo sobre ela antes de comê-la, e nesse
+    // passo é a cabeça que aparece (como no desenho com quadrados, em que a cobra cobre a comida).
+    if (hasFood)
+    {
+        cells[(size_t)food.y * width + food.x] = BOARD_FOOD;
+    }
+    for (size_t i = 1; i < body.size(); ++i)
+    {
+        cells[(size_t)body[i].y * width + body[i].x] = BOARD_BODY;
+    }
+    cells[(size_t)body[0].y * width + body[0].x] = BOARD_HEAD;
+    dirty.clear();
+    fullUpload = true;
+}
+
+// --- REGISTRAR UM MOVIMENTO ---
+// A ordem importa: o rabo é apagado antes de a cabeça ser escrita, porque a cabeça
+// pode entrar exatamente na célula que o rabo acabou de deixar.
+void BoardTexture::recordMove(const RingBuffer<GridPosition>& body, const GridPosition& removedTail, bool grew)
+{
+    if (!grew)
+    {
+        set(removedTail, BOARD_EMPTY);
+    }
+    if (body.size() > 1)
+    {
+        set(body[1], BOARD_BODY);
+    }
+    set(body[0], BOARD_HEAD);
+}
+
+// --- POSICIONAR A COMIDA ---
+// Chamado depois dos movimentos. A comida aparece em uma célula livre, mas, quando vários
+// passos chegam de uma vez, a cabeça pode já ter entrado nela; nesse caso a cobra a cobre.
+void BoardTexture::placeFood(const GridPosition& food)
+{
+    if (cells[(size_t)food.y * width + food.x] == BOARD_EMPTY)
+    {
+        set(food, BOARD_FOOD);
+    }
+}
+
+// --- ENVIAR ---
+void BoardTexture::upload()
+{
+    if (!fullUpload && dirty.empty())
+    {
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (fullUpload)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_BYTE, cells.data());
+        fullUpload = false;
+    }
+    else
+    {
+        // Um texel por célula alterada. Uma mesma célula pode aparecer mais de uma vez
+        // (vários passos no mesmo frame); o valor enviado é sempre o atual da cópia.
+        for (const GridPosition& p : dirty)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, p.x, p.y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+                            &cells[(size_t)p.y * width + p.x]);
+        }
+    }
+    dirty.clear();
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// --- ASSOCIAR ---
+void BoardTexture::bind(unsigned int unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+// --- MARCAR CÉLULA ---
+void BoardTexture::set(const GridPosition& p, BoardCell cell)
+{
+    cells[(size_t)p.y * width + p.x] = cell;
+    // Depois de um 'rebuild', a textura inteira já será enviada.
+    if (!fullUpload)
+    {
+        dirty.push_back(p);
+    }
+}
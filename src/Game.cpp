@@ -1,33 +1,65 @@
 // Inclui o cabeçalho da classe Game, que contém as declarações.
 #include "Game.h"
-// Inclui bibliotecas padrão para entrada/saída, números aleatórios e tempo.
+// Inclui bibliotecas padrão para entrada/saída e funções matemáticas.
 #include <iostream>
+#include <string>
 #include <cstdlib>
-#include <ctime>
+#include <cmath>
+#include <map>
+#include <algorithm>
+#include <chrono>
 // Inclui os cabeçalhos da biblioteca GLM para transformações matriciais.
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-// --- FUNÇÃO AUXILIAR ---
-// Gera um número inteiro aleatório dentro de um intervalo [min, max].
-// É usada para determinar a nova posição da comida.
-int randomRange(int min, int max)
-{
-    // A fórmula `min + rand() % (max - min + 1)` garante uma distribuição uniforme no intervalo.
-    return min + (rand() % (max - min + 1));
-}
-
 // --- CONSTRUTOR ---
 // Inicializa os membros da classe Game.
-Game::Game(unsigned int width, unsigned int height)
+Game::Game(unsigned int width, unsigned int height, int gridWidth, int gridHeight,
+           uint64_t seed, const char* replayPath)
     // Usa uma lista de inicialização para definir os valores iniciais das variáveis membro.
     : screenWidth(width), screenHeight(height),   // Define as dimensões da tela.
-      gridWidth(20), gridHeight(20),             // Define as dimensões do grid do jogo.
-      snake(gridWidth / 4, gridHeight / 2),     // Cria a cobra no primeiro quarto do grid.
-      food({15, 10}),                           // Posição inicial da comida.
-      window(nullptr), shader(nullptr),         // Inicializa ponteiros como nulos.
-      VAO(0), VBO(0)                            // Inicializa IDs do OpenGL como 0.
+      gridWidth(gridWidth), gridHeight(gridHeight), // Define as dimensões do grid do jogo.
+      state(gridWidth, gridHeight, seed),       // Cria a partida com a cobra e a comida iniciais.
+      tickInterval(0.15),                       // Um passo a cada 0.15 s.
+      publisher(snapshots),                     // Publica no buffer triplo do jogo.
+      simulationRunning(false),
+      renderBody(state.snake.getBody().capacity()), // Mesma capacidade do corpo da simulação.
+      renderFood(state.food), renderTick(0),
+      droppedInputs(0),                         // Nenhuma tecla perdida ainda.
+      replay(nullptr),                          // Sem gravação até que um arquivo seja aberto.
+      window(nullptr),                          // Inicializa ponteiros como nulos.
+      segmentShader(nullptr), gridShader(nullptr),
+      VAO(0), VBO(0),                           // Inicializa IDs do OpenGL como 0.
+      segments(nullptr), board(nullptr), boardShader(nullptr), gpuTimer(nullptr),
+      idleRendering(false), needsRedraw(true)
 {
+    // SNAKE_TICK_RATE muda o número de passos por segundo (ex: para testes ou modos rápidos).
+    const char* tickRate = std::getenv("SNAKE_TICK_RATE");
+    if (tickRate != nullptr && std::strtod(tickRate, nullptr) > 0.0)
+    {
+        tickInterval = 1.0 / std::strtod(tickRate, nullptr);
+    }
+
+#ifdef SNAKE_TRACING
+    // SNAKE_TRACE=arquivo.json grava um trace das fases do jogo, escrito ao fechar a janela.
+    const char* tracePath = std::getenv("SNAKE_TRACE");
+    if (tracePath != nullptr && tracePath[0] != '\0')
+    {
+        beginTracing(tracePath);
+    }
+#endif
+
+    // O modo ocioso (redesenhar só quando algo muda) é ligado com SNAKE_IDLE=1.
+    const char* idle = std::getenv("SNAKE_IDLE");
+    idleRendering = idle != nullptr && std::string(idle) != "0";
+
+    // Abre o arquivo de replay, se pedido. A semente e as dimensões do grid vão no
+    // cabeçalho, e cada passo acrescenta a direção em que a cobra andou.
+    if (replayPath != nullptr)
+    {
+        replay = new ReplayWriter(replayPath, gridWidth, gridHeight, seed);
+    }
+
     // Chama o método init() para configurar a janela e o OpenGL.
     init();
 }
@@ -36,8 +68,32 @@ Game::Game(unsigned int width, unsigned int height)
 // Libera os recursos alocados dinamicamente.
 Game::~Game()
 {
-    // Deleta o objeto shader para evitar vazamento de memória.
-    delete shader;
+    // Para a thread da simulação, caso 'run' não tenha terminado normalmente.
+    if (simulationThread.joinable())
+    {
+        simulationRunning.store(false);
+        simulationThread.join();
+    }
+    // Para a thread que observa os shaders.
+    shaderWatcher.stop();
+    // Mostra a latência entre as teclas e os passos que as aplicaram.
+    if (inputLatency.applied > 0)
+    {
+        std::cout << "Entrada: " << inputLatency.applied << " curvas, latência média "
+                  << inputLatency.mean() * 1000.0 << " ms, máxima " << inputLatency.max * 1000.0
+                  << " ms; " << inputLatency.rejected << " teclas descartadas, "
+                  << droppedInputs.load() << " perdidas." << std::endl;
+    }
+    // Deleta os shaders e o corpo da cobra na GPU para evitar vazamento de memória.
+    // Isso precisa acontecer antes de 'glfwTerminate', enquanto o contexto OpenGL existe.
+    delete segmentShader;
+    delete gridShader;
+    delete segments;
+    delete board;
+    delete boardShader;
+    delete gpuTimer;
+    // Deleta o gravador, o que grava os últimos passos do replay no arquivo.
+    delete replay;
     // Encerra a biblioteca GLFW, liberando todos os recursos que ela alocou.
     glfwTerminate();
 }
@@ -71,6 +127,15 @@ void Game::init()
     glfwMakeContextCurrent(window);
     // Registra a função de callback que será chamada sempre que a janela for redimensionada.
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    // O callback de teclado registra as setas na fila de entrada; ele e o de "refresh" também
+    // marcam que a tela precisa ser redesenhada (usado no modo ocioso).
+    // O GLFW os chama com a janela; o ponteiro para o jogo fica guardado nela.
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
+    // Com "sticky keys", um ESC apertado e solto durante a espera do modo ocioso ainda
+    // aparece como pressionado no próximo 'glfwGetKey', em vez de ser perdido.
+    glfwSetInputMode(window, GLFW_STICKY_KEYS, GLFW_TRUE);
 
     // Inicializa a biblioteca GLAD para carregar os ponteiros de função do OpenGL.
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -79,8 +144,14 @@ void Game::init()
         return;
     }
 
-    // Inicializa o gerador de números aleatórios com a hora atual para garantir valores diferentes a cada execução.
-    srand((unsigned int)time(0));
+    // Liga o cache de programas de shader, que evita recompilar o GLSL a cada execução.
+    // O diretório pode ser escolhido com a variável de ambiente SNAKE_SHADER_CACHE
+    // ('off' desliga o cache); o padrão segue a convenção XDG (~/.cache/snake-game).
+    std::string cacheDirectory = shaderCacheDirectory();
+    if (!cacheDirectory.empty())
+    {
+        Shader::enableBinaryCache(cacheDirectory, (GLADloadproc)glfwGetProcAddress);
+    }
 
     // --- CONFIGURAÇÃO DOS VÉRTICES DO QUADRADO (COBRA E COMIDA) ---
     // Um quadrado é formado por dois triângulos. Estes são os vértices de um quadrado centrado em (0,0).
@@ -114,43 +185,59 @@ void Game::init()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
-    // --- CONFIGURAÇÃO DOS VÉRTICES DO GRID ---
-    // Cria os vértices para as linhas verticais e horizontais do grid.
-    std::vector<float> gridVertices;
-    // Linhas verticais
-    for (int i = 0; i <= gridWidth; ++i) {
-        gridVertices.push_back((float)i); gridVertices.push_back(0.0f); gridVertices.push_back(0.0f); // Ponto inicial
-        gridVertices.push_back((float)i); gridVertices.push_back((float)gridHeight); gridVertices.push_back(0.0f); // Ponto final
+    // --- CORPO DA COBRA NA GPU ---
+    // Um anel com a mesma capacidade do corpo na CPU; a cobra e a comida são desenhadas
+    // a partir dele com uma única chamada 'glDrawArraysInstanced' (veja 'drawSnake').
+    // Em grids enormes, o tabuleiro em textura substitui o anel (veja 'BoardTexture').
+    bool useBoardTexture = (long long)gridWidth * gridHeight >= BOARD_TEXTURE_MIN_CELLS;
+    if (useBoardTexture)
+    {
+        // O conteúdo vem da primeira fotografia da simulação (veja 'consumeSnapshot').
+        board = new BoardTexture(gridWidth, gridHeight);
     }
-    // Linhas horizontais
-    for (int i = 0; i <= gridHeight; ++i) {
-        gridVertices.push_back(0.0f); gridVertices.push_back((float)i); gridVertices.push_back(0.0f); // Ponto inicial
-        gridVertices.push_back((float)gridWidth); gridVertices.push_back((float)i); gridVertices.push_back(0.0f); // Ponto final
+    else
+    {
+        segments = new SegmentBuffer(renderBody.capacity());
     }
 
-    // Gera e configura o VAO e VBO para o grid, de forma similar ao quadrado.
-    glGenVertexArrays(1, &gridVAO);
-    glGenBuffers(1, &gridVBO);
+    // --- CRIAÇÃO DOS SHADERS ---
+    // Shader da cobra e da comida, que lê o corpo de 'segments'.
+    segmentShader = new Shader("snakeSegments.vert", "snakeColor.frag");
+    // Shader do grid. As linhas são calculadas no fragment shader a partir da posição de cada
+    // pixel no grid, então o grid não tem VBO: mudar o tamanho do tabuleiro é só mudar os uniforms.
+    gridShader = new Shader("grid.vert", "grid.frag");
+    // Shader do tabuleiro em textura: reaproveita o triângulo de tela cheia do grid,
+    // e o fragment shader lê a textura.
+    if (useBoardTexture)
+    {
+        boardShader = new Shader("grid.vert", "board.frag");
+    }
+    configureShaders();
 
-    glBindVertexArray(gridVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
-    glBufferData(GL_ARRAY_BUFFER, gridVertices.size() * sizeof(float), gridVertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // As bordas antisserrilhadas das linhas são misturadas com o que já foi desenhado.
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // --- CONFIGURAÇÃO DO SHADER E PROJEÇÃO ---
-    // Cria e carrega os shaders (vertex e fragment).
-    shader = new Shader("res/shaders/snakeVertex.vert", "res/shaders/snakeColor.frag");
-    shader->use(); // Ativa o programa de shader.
+#ifdef SNAKE_INSTRUMENTATION
+    // Mede o tempo de cada passagem na GPU, junto com as outras métricas.
+    gpuTimer = new GpuTimer();
+#endif
 
-    // Obtém a localização das variáveis 'uniform' no shader.
-    // 'uniforms' são variáveis globais no shader que podemos definir a partir do nosso código C++.
-    projectionLoc = glGetUniformLocation(shader->ID, "projection");
-    modelLoc = glGetUniformLocation(shader->ID, "model");
-    colorLoc = glGetUniformLocation(shader->ID, "objectColor");
+    // --- RECARGA DOS SHADERS ---
+    // Em desenvolvimento (SNAKE_SHADER_DIR definido), os shaders editados nesse diretório
+    // são recarregados sem reiniciar o jogo (veja 'reloadShaders').
+    std::string shaderDirectory = shaderOverrideDirectory();
+    if (!shaderDirectory.empty() && shaderWatcher.start(shaderDirectory))
+    {
+        std::cout << "Observando os shaders em " << shaderDirectory << std::endl;
+    }
+}
 
+// --- CONFIGURAÇÃO DOS SHADERS ---
+// Define os uniforms que não mudam durante o jogo e guarda as localizações dos que mudam.
+// Os valores dos uniforms pertencem a cada programa, então isto é refeito sempre que um
+// shader é recarregado.
+void Game::configureShaders()
+{
     // Cria uma matriz de projeção ortográfica.
     // Isso mapeia nosso sistema de coordenadas do grid (0 a gridWidth, 0 a gridHeight)
     // para as coordenadas de clipe normalizadas (-1 a 1) que o OpenGL usa.
@@ -159,9 +246,116 @@ void Game::init()
         0.0f, (float)gridHeight,   // Baixo, Cima
         -1.0f, 1.0f                // Z-perto, Z-longe
     );
+    glm::mat4 inverseProjection = glm::inverse(projection);
+
+    // --- SHADER DA COBRA E DA COMIDA ---
+    segmentShader->use();
+    segmentShader->setMat4("projection", projection);
+    segmentShader->setInt("segments", 0); // A textura de buffer fica na unidade 0.
+    segmentShader->setInt("capacity", (int)renderBody.capacity());
+    segmentShader->setVec4("snakeColor", glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+    segmentShader->setVec4("foodColor", glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    segmentShader->setVec4("objectColor", glm::vec4(1.0f));
+
+    headSlotLoc = segmentShader->getUniformLocation("headSlot");
+    segmentCountLoc = segmentShader->getUniformLocation("segmentCount");
+    previousTailLoc = segmentShader->getUniformLocation("previousTail");
+    alphaLoc = segmentShader->getUniformLocation("alpha");
+    foodLoc = segmentShader->getUniformLocation("food");
+
+    // --- SHADER DO GRID ---
+    gridShader->use();
+    gridShader->setMat4("inverseProjection", inverseProjection);
+    gridShader->setVec2("gridSize", glm::vec2((float)gridWidth, (float)gridHeight));
+    gridShader->setVec4("lineColor", glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
+    gridShader->setFloat("lineWidth", 1.0f);
+
+    // --- SHADER DO TABULEIRO EM TEXTURA ---
+    if (boardShader != nullptr)
+    {
+        boardShader->use();
+        boardShader->setMat4("inverseProjection", inverseProjection);
+        boardShader->setVec2("gridSize", glm::vec2((float)gridWidth, (float)gridHeight));
+        boardShader->setInt("board", 0); // A textura do tabuleiro fica na unidade 0.
+        // Cores de cada código: vazia (preta), corpo (verde), cabeça (verde-claro) e comida (vermelha).
+        const float palette[] = {
+            0.0f, 0.0f, 0.0f, 1.0f,
+            0.0f, 1.0f, 0.0f, 1.0f,
+            0.6f, 1.0f, 0.6f, 1.0f,
+            1.0f, 0.0f, 0.0f, 1.0f
+        };
+        // Arrays não passam pelo cache de valores: são enviados uma única vez, direto.
+        glUniform4fv(boardShader->getUniformLocation("palette"), 4, palette);
+    }
+}
+
+// --- RECARGA DOS SHADERS ---
+// Chamado entre dois frames quando o observador encontrou arquivos alterados. Os arquivos
+// já foram lidos pela thread do observador; aqui só se compila. Um shader que não compila
+// é descartado e o anterior continua em uso, então um erro de digitação não derruba o jogo.
+void Game::reloadShaders()
+{
+    std::map<std::string, std::string> changes = shaderWatcher.takeChanges();
+    Shader** programs[] = {&segmentShader, &gridShader, &boardShader};
+
+    bool reloaded = false;
+    for (Shader** program : programs)
+    {
+        Shader* current = *program;
+        if (current == nullptr)
+        {
+            continue;
+        }
+        auto vertex = changes.find(current->getVertexName());
+        auto fragment = changes.find(current->getFragmentName());
+        if (vertex == changes.end() && fragment == changes.end())
+        {
+            continue;
+        }
+
+        // O arquivo que não mudou é reaproveitado do programa atual.
+        Shader* candidate = new Shader(current->getVertexName().c_str(), current->getFragmentName().c_str(),
+                                       vertex != changes.end() ? vertex->second : current->getVertexCode(),
+                                       fragment != changes.end() ? fragment->second : current->getFragmentCode());
+        if (candidate->isLinked())
+        {
+            std::cout << "Shader recarregado: " << current->getVertexName() << " + " << current->getFragmentName() << std::endl;
+            delete current;
+            *program = candidate;
+            reloaded = true;
+        }
+        else
+        {
+            std::cout << "Shader com erro, mantendo o anterior: " << current->getVertexName() << " + " << current->getFragmentName() << std::endl;
+            delete candidate;
+        }
+    }
+
+    if (reloaded)
+    {
+        configureShaders();
+    }
+}
 
-    // Envia a matriz de projeção para o shader. Ela não mudará durante o jogo.
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+// --- DIRETÓRIO DO CACHE DE SHADERS ---
+// Escolhe onde guardar os programas de shader já compilados. Retorna vazio para desligar o cache.
+std::string Game::shaderCacheDirectory()
+{
+    const char* configured = std::getenv("SNAKE_SHADER_CACHE");
+    if (configured != nullptr)
+    {
+        std::string directory = configured;
+        return directory == "off" ? std::string() : directory;
+    }
+    if (const char* xdgCache = std::getenv("XDG_CACHE_HOME"))
+    {
+        return std::string(xdgCache) + "/snake-game/shaders";
+    }
+    if (const char* home = std::getenv("HOME"))
+    {
+        return std::string(home) + "/.cache/snake-game/shaders";
+    }
+    return "shader_cache";
 }
 
 // --- CALLBACK DE REDIMENSIONAMENTO ---
@@ -170,180 +364,478 @@ void Game::framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
     // Ajusta o viewport do OpenGL para cobrir a nova dimensão da janela.
     glViewport(0, 0, width, height);
+    requestRedraw(window);
+}
+
+// --- CALLBACKS DE TECLADO E REDESENHO ---
+// Cada seta pressionada entra na fila de entrada com o instante em que chegou, então duas
+// teclas rápidas dentro do mesmo passo não se sobrescrevem (veja 'update').
+// Uma tecla ou uma parte da janela que precisa ser redesenhada (ex: depois de ser coberta
+// por outra janela) pedem um novo frame.
+void Game::key_callback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/)
+{
+    Game* game = (Game*)glfwGetWindowUserPointer(window);
+    if (game != nullptr && action == GLFW_PRESS)
+    {
+        InputEvent event;
+        event.time = glfwGetTime();
+        bool arrow = true;
+        switch (key)
+        {
+        case GLFW_KEY_UP:
+            event.direction = Direction::UP;
+            break;
+        case GLFW_KEY_DOWN:
+            event.direction = Direction::DOWN;
+            break;
+        case GLFW_KEY_LEFT:
+            event.direction = Direction::LEFT;
+            break;
+        case GLFW_KEY_RIGHT:
+            event.direction = Direction::RIGHT;
+            break;
+        default:
+            arrow = false;
+            break;
+        }
+        if (arrow && !game->inputEvents.push(event))
+        {
+            game->droppedInputs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    requestRedraw(window);
+}
+
+void Game::window_refresh_callback(GLFWwindow* window)
+{
+    requestRedraw(window);
+}
+
+void Game::requestRedraw(GLFWwindow* window)
+{
+    Game* game = (Game*)glfwGetWindowUserPointer(window);
+    if (game != nullptr)
+    {
+        game->needsRedraw = true;
+    }
 }
 
 // --- LOOP PRINCIPAL DO JOGO (RUN) ---
-// Contém o loop que executa até o jogador fechar a janela.
+// Contém o loop que executa até o jogador fechar a janela. A simulação roda em outra
+// thread (veja 'simulationLoop'); este loop só lê o teclado e desenha.
 void Game::run()
 {
-    float lastTime = 0.0f; // Armazena o tempo do último update.
-    const float MOVE_INTERVAL = 0.15f; // Intervalo de tempo (em segundos) entre cada movimento da cobra.
+    // A primeira fotografia (o corpo inteiro da partida inicial) é publicada e aplicada
+    // antes de a simulação começar, então o primeiro frame já tem o que desenhar.
+    publisher.publish(state, glfwGetTime());
+    consumeSnapshot();
+
+    SNAKE_TRACE_THREAD("principal");
+    simulationRunning.store(true);
+    simulationThread = std::thread(&Game::simulationLoop, this);
+
+#ifdef SNAKE_INSTRUMENTATION
+    // Um SIGUSR1 (ex: 'kill -USR1 <pid>') imprime as métricas sem fechar o jogo.
+    installMetricsSignal();
+    double previousFrameStart = glfwGetTime();
+#endif
 
     // Loop principal: continua enquanto a janela não deve ser fechada.
     while (!glfwWindowShouldClose(window))
     {
+#ifdef SNAKE_INSTRUMENTATION
+        // O tempo de frame é o intervalo entre dois inícios de frame, que inclui tudo
+        // (e também a espera do modo ocioso).
+        double frameStart = glfwGetTime();
+        SNAKE_RECORD_METRIC(Metric::FRAME, (uint64_t)((frameStart - previousFrameStart) * 1e9));
+        previousFrameStart = frameStart;
+        if (takeMetricsRequest())
+        {
+            printMetrics(std::cout);
+        }
+#endif
+
         // 1. Processa entradas do usuário.
         processInput();
 
-        // 2. Atualiza o estado do jogo em intervalos fixos.
-        float currentTime = (float)glfwGetTime(); // Obtém o tempo atual.
-        if (currentTime - lastTime >= MOVE_INTERVAL)
+        // 2. Pega a fotografia mais recente da simulação, se houver uma nova. Nunca espera:
+        // sem fotografia nova, o frame desenha a mesma de antes.
+        if (consumeSnapshot())
         {
-            update(); // Move a cobra, verifica colisões, etc.
-            lastTime = currentTime; // Atualiza o tempo do último movimento.
+            needsRedraw = true;
+        }
+
+        // Recarrega os shaders alterados em disco, entre dois frames.
+        if (shaderWatcher.hasChanges())
+        {
+            SNAKE_TRACE_SCOPE("reloadShaders");
+            reloadShaders();
+            needsRedraw = true;
         }
 
-        // 3. Renderiza o frame atual.
-        render();
+        if (idleRendering)
+        {
+            // 3. Modo ocioso: só desenha quando algo mudou (um passo, uma tecla, a janela
+            // redimensionada ou exposta). Sem interpolação, a cobra é desenhada no passo atual.
+            if (needsRedraw)
+            {
+                render(1.0f);
+                SNAKE_TIMED_SCOPE(Metric::SWAP);
+                SNAKE_TRACE_SCOPE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
+                needsRedraw = false;
+            }
+            // 4. Dorme até chegar um evento: uma tecla, a janela ou um passo da simulação,
+            // que acorda esta espera com 'glfwPostEmptyEvent' depois de publicar.
+            SNAKE_TIMED_SCOPE(Metric::EVENTS);
+            SNAKE_TRACE_SCOPE("glfwWaitEvents");
+            glfwWaitEvents();
+            continue;
+        }
+
+        // 3. Renderiza o frame atual, interpolando entre o passo anterior e o atual pelo
+        // tempo que já passou desde o horário do último passo.
+        double alpha = (glfwGetTime() - snapshots.readBuffer().time) / tickInterval;
+        render((float)std::min(std::max(alpha, 0.0), 1.0));
 
         // 4. Troca os buffers da janela (double buffering) para exibir o que foi desenhado.
-        glfwSwapBuffers(window);
+        {
+            SNAKE_TIMED_SCOPE(Metric::SWAP);
+            SNAKE_TRACE_SCOPE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
         // 5. Processa eventos do sistema (como fechar a janela, movimento do mouse, etc.).
-        glfwPollEvents();
+        {
+            SNAKE_TIMED_SCOPE(Metric::EVENTS);
+            SNAKE_TRACE_SCOPE("glfwPollEvents");
+            glfwPollEvents();
+        }
+    }
+
+    // Para a simulação antes de sair (o destrutor ainda grava o replay e mostra as estatísticas).
+    simulationRunning.store(false);
+    simulationThread.join();
+
+#ifdef SNAKE_INSTRUMENTATION
+    printMetrics(std::cout);
+#endif
+#ifdef SNAKE_TRACING
+    // As duas threads que gravam eventos já pararam (a do observador de shaders não grava).
+    if (isTracing())
+    {
+        const char* tracePath = std::getenv("SNAKE_TRACE");
+        if (finishTracing())
+        {
+            std::cout << "Trace gravado em " << tracePath << std::endl;
+        }
+        else
+        {
+            std::cerr << "ERRO::TRACE::FALHA_AO_GRAVAR: " << tracePath << std::endl;
+        }
+    }
+#endif
+}
+
+// --- LOOP DA SIMULAÇÃO ---
+// Executa os passos no horário, em uma thread só dela, e publica uma fotografia depois de
+// cada grupo de passos. Só esta thread usa 'state', 'turns', 'inputLatency' e 'replay'.
+void Game::simulationLoop()
+{
+    // Se a thread atrasar demais (ex: o sistema ficou suspenso), descarta os passos
+    // excedentes em vez de acelerar o jogo para recuperá-los.
+    const double MAX_LAG = 0.25;
+
+    // O tempo é guardado em 'double': um 'float' perde precisão depois de algumas horas
+    // de execução, enquanto um 'double' continua exato por anos.
+    // 'nextTick' é o horário do próximo passo; os passos seguem esses horários, e não o
+    // momento em que a thread acorda, então o ritmo do jogo não acumula atrasos.
+    SNAKE_TRACE_THREAD("simulacao");
+    double nextTick = glfwGetTime() + tickInterval;
+    while (simulationRunning.load(std::memory_order_acquire))
+    {
+        double now = glfwGetTime();
+        if (now < nextTick)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(nextTick - now));
+            continue;
+        }
+        if (now - nextTick > MAX_LAG)
+        {
+            nextTick = now;
+        }
+
+        // Executa todos os passos cujo horário já chegou (em modos rápidos, vários por vez).
+        double tickTime = nextTick;
+        while (nextTick <= now)
+        {
+            update(); // Move a cobra, verifica colisões, etc.
+            tickTime = nextTick;
+            nextTick += tickInterval;
+        }
+
+        {
+            SNAKE_TRACE_SCOPE("publish");
+            publisher.publish(state, tickTime);
+        }
+        // No modo ocioso, a thread principal está dormindo em 'glfwWaitEvents'.
+        if (idleRendering)
+        {
+            glfwPostEmptyEvent();
+        }
+    }
+}
+
+// --- APLICAR FOTOGRAFIA ---
+// Atualiza a cópia do corpo, o anel na GPU e o tabuleiro em textura com os movimentos da
+// fotografia mais recente (ou com o corpo inteiro, depois de um reinício).
+bool Game::consumeSnapshot()
+{
+    if (!snapshots.consume())
+    {
+        return false;
+    }
+    SNAKE_TRACE_SCOPE("consumeSnapshot");
+    const RenderSnapshot& snapshot = snapshots.readBuffer();
+
+    if (snapshot.full)
+    {
+        // O corpo vem da cabeça ao rabo; inserir de trás para frente deixa a cabeça no índice 0.
+        renderBody.clear();
+        for (size_t i = snapshot.body.size(); i > 0; --i)
+        {
+            renderBody.push_front(snapshot.body[i - 1]);
+        }
+        // O corpo foi refeito sem passar por 'push_front' a partir do anterior, então a
+        // cópia na GPU precisa ser reenviada inteira.
+        if (segments != nullptr)
+        {
+            segments->invalidate();
+        }
+        if (board != nullptr)
+        {
+            board->rebuild(renderBody, snapshot.food, snapshot.hasFood);
+        }
+    }
+    else
+    {
+        // Aplica só os movimentos que esta cópia ainda não viu, na mesma ordem de 'Snake::advance'.
+        size_t applied = 0;
+        for (size_t i = 0; i < snapshot.moves.size(); ++i)
+        {
+            if (snapshot.firstMoveTick + i <= renderTick)
+            {
+                continue;
+            }
+            ++applied;
+            const SnakeMove& move = snapshot.moves[i];
+            GridPosition removedTail = renderBody.back();
+            if (!move.grew)
+            {
+                renderBody.pop_back();
+            }
+            renderBody.push_front(move.head);
+            if (board != nullptr)
+            {
+                board->recordMove(renderBody, removedTail, move.grew);
+            }
+        }
+        // 'SegmentBuffer::sync' conta as cabeças novas pela distância entre a cabeça antiga e
+        // a atual no anel, que dá a volta com 'capacity' passos ou mais. Uma fotografia traz
+        // até SnapshotPublisher::MAX_MOVES passos, e o anel de um grid 20x20 tem só 400
+        // posições: nesse caso, o corpo é reenviado inteiro.
+        if (segments != nullptr && applied >= renderBody.capacity())
+        {
+            segments->invalidate();
+        }
+        if (board != nullptr && snapshot.hasFood &&
+            !(snapshot.food == renderFood))
+        {
+            board->placeFood(snapshot.food);
+        }
     }
+
+    renderFood = snapshot.food;
+    renderTick = snapshot.tick;
+    publisher.acknowledge(snapshot.tick);
+    return true;
 }
 
 // --- PROCESSAMENTO DE ENTRADA ---
 // Verifica o estado das teclas e atualiza o estado do jogo.
 void Game::processInput()
 {
+    SNAKE_TIMED_SCOPE(Metric::INPUT);
+    SNAKE_TRACE_SCOPE("processInput");
+
     // Fecha o jogo se a tecla ESC for pressionada.
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
 
-    // Muda a direção da cobra com base nas teclas de seta.
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-        snake.changeDirection(Direction::UP);
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-        snake.changeDirection(Direction::DOWN);
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        snake.changeDirection(Direction::RIGHT);
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-        snake.changeDirection(Direction::LEFT);
+    // As setas não são lidas aqui: o callback de teclado as registra na fila de entrada
+    // no instante em que chegam, sem depender de quando este método é chamado.
+}
+
+// Converte uma direção na ação da simulação que pede essa direção.
+static Action toAction(Direction direction)
+{
+    switch (direction)
+    {
+    case Direction::UP:
+        return Action::UP;
+    case Direction::DOWN:
+        return Action::DOWN;
+    case Direction::LEFT:
+        return Action::LEFT;
+    default:
+        return Action::RIGHT;
+    }
 }
 
 // --- ATUALIZAÇÃO DO JOGO (UPDATE) ---
-// Responsável pela lógica do jogo que acontece a cada passo de tempo.
+// Avança a simulação em um passo com a próxima curva pedida pelo teclado.
 void Game::update()
 {
-    // Verifica se a cabeça da cobra está na mesma posição da comida.
-    bool ateFood = (snake.getHead() == food);
+    SNAKE_TIMED_SCOPE(Metric::TICK);
+    SNAKE_TRACE_SCOPE("update");
 
-    // Move a cobra. Se 'ateFood' for true, a cobra crescerá.
-    snake.move(ateFood);
+    // Move as teclas que chegaram desde o último passo para o buffer de curvas, que
+    // descarta as que não mudam a direção, invertem a cobra ou passam do limite.
+    InputEvent event;
+    while (inputEvents.pop(event))
+    {
+        if (!turns.push(event, state.snake.getCurrentDirection()))
+        {
+            ++inputLatency.rejected;
+        }
+    }
 
-    // Verifica as condições de fim de jogo.
-    if (snake.isOutOfBounds(gridWidth, gridHeight) || snake.isSelfCollision())
+    // Aplica uma curva por passo; as demais ficam para os próximos passos.
+    Action action = Action::NONE;
+    if (turns.pop(event))
     {
-        std::cout << "GAME OVER! Pontuação: " << snake.getBody().size() - 1 << std::endl;
-        resetGame(); // Reinicia o jogo.
+        action = toAction(event.direction);
+        double latency = glfwGetTime() - event.time;
+        inputLatency.record(latency);
+        SNAKE_RECORD_METRIC(Metric::INPUT_LATENCY, (uint64_t)(latency * 1e9));
     }
 
-    // Se a cobra comeu, gera uma nova comida.
-    if (ateFood)
+    // As regras (movimento, colisões, comida) ficam em 'step', na biblioteca snake_core.
+    StepResult result = step(state, action);
+
+    // Grava a direção em que a cobra andou, antes que um reinício a altere.
+    if (replay != nullptr)
     {
-        food = generateNewFood();
+        replay->record(state.snake.getCurrentDirection());
     }
-}
 
-// --- RENDERIZAÇÃO ---
-// Limpa a tela e desenha todos os elementos do jogo.
-void Game::render()
-{
-    // Limpa o buffer de cor com a cor preta.
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    // Ativa o nosso programa de shader para todos os desenhos deste frame.
-    shader->use();
-
-    // Desenha a comida (um quadrado vermelho).
-    drawSquare(food, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-
-    // Desenha a cobra (uma série de quadrados verdes).
-    glm::vec4 snakeColor(0.0f, 1.0f, 0.0f, 1.0f);
-    for (const auto &segment : snake.getBody())
-    {
-        drawSquare(segment, snakeColor);
-    }
-
-    // Desenha o grid de fundo.
-    // Reseta a matriz 'model' para a matriz identidade.
-    // Isso garante que o grid não seja afetado pelas transformações (translação)
-    // usadas para desenhar a cobra e a comida.
-    glm::mat4 model = glm::mat4(1.0f);
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    // Define a cor do grid (cinza escuro).
-    glUniform4f(colorLoc, 0.2f, 0.2f, 0.2f, 1.0f);
-    // Ativa o VAO do grid.
-    glBindVertexArray(gridVAO);
-    // Desenha as linhas do grid.
-    glDrawArrays(GL_LINES, 0, (gridWidth + gridHeight + 2) * 2);
-    // Desativa o VAO.
-    glBindVertexArray(0);
-}
+    // Informa o resultado da partida e reinicia o jogo.
+    if (result.gameOver)
+    {
+        std::cout << "GAME OVER! Pontuação: " << state.getScore() << std::endl;
+        resetGame(state);
+    }
+    else if (result.won)
+    {
+        std::cout << "VITÓRIA! Pontuação: " << state.getScore() << std::endl;
+        resetGame(state);
+    }
+    // Curvas pedidas para a partida que terminou não passam para a próxima.
+    bool restarted = result.gameOver || result.won;
+    if (restarted)
+    {
+        turns.clear();
+    }
 
-// --- REINICIAR O JOGO ---
-// Reseta a cobra e a comida para suas posições iniciais.
-void Game::resetGame()
-{
-    snake = Snake(gridWidth / 4, gridHeight / 2);
-    food = generateNewFood();
+    // Guarda o movimento para a próxima fotografia. O desenho (anel na GPU e tabuleiro em
+    // textura) é atualizado pela thread principal a partir das fotografias.
+    publisher.recordStep(state, result, restarted);
+
+    // Grava periodicamente o estado completo (keyframe), já depois de um eventual reinício.
+    if (replay != nullptr)
+    {
+        replay->recordState(state);
+    }
 }
 
-// --- GERAR NOVA COMIDA ---
-// Encontra uma nova posição aleatória para a comida que não esteja sobre a cobra.
-GridPosition Game::generateNewFood()
+// --- RENDERIZAÇÃO ---
+// Limpa a tela e desenha todos os elementos do jogo.
+void Game::render(float alpha)
 {
-    GridPosition newPosition;
-    bool validPosition = false;
+    SNAKE_TIMED_SCOPE(Metric::RENDER);
+    SNAKE_TRACE_SCOPE("render");
 
-    // Continua gerando novas posições até encontrar uma que seja válida.
-    while (!validPosition)
+    // Cada passagem abaixo fica em um bloco, medido na GPU por 'gpuTimer' (se houver).
+    if (gpuTimer != nullptr)
     {
-        // Gera uma posição aleatória dentro dos limites do grid.
-        newPosition.x = randomRange(0, gridWidth - 1);
-        newPosition.y = randomRange(0, gridHeight - 1);
+        gpuTimer->beginFrame();
+    }
 
-        // Assume que a posição é válida até que se prove o contrário.
-        validPosition = true;
+    // Limpa o buffer de cor com a cor preta.
+    {
+        GpuTimerScope pass(gpuTimer, Metric::GPU_CLEAR);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
 
-        // Verifica se a nova posição colide com algum segmento do corpo da cobra.
-        for (const auto &segment : snake.getBody())
+    // A cobra e a comida são uma única chamada instanciada, então são medidas juntas.
+    {
+        GpuTimerScope pass(gpuTimer, Metric::GPU_SNAKE);
+        if (board != nullptr)
         {
-            if (newPosition == segment)
-            {
-                validPosition = false; // Posição inválida, tenta novamente.
-                break;
-            }
+            // Grid enorme: envia as células alteradas e desenha o tabuleiro inteiro com um
+            // único triângulo de tela cheia. Neste modo não há interpolação entre passos.
+            board->upload();
+            board->bind(0);
+            boardShader->use();
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glBindVertexArray(0);
+        }
+        else
+        {
+            // Desenha a cobra e a comida com uma única chamada.
+            drawSnake(alpha);
         }
     }
 
-    return newPosition;
+    // Desenha o grid por cima, com um único triângulo que cobre a tela inteira.
+    // O custo não depende do tamanho do tabuleiro: cada pixel decide sozinho se está
+    // sobre uma linha. O perfil Core exige um VAO ativo mesmo sem atributos, então
+    // usamos o do quadrado (o shader do grid não lê nenhum atributo).
+    {
+        GpuTimerScope pass(gpuTimer, Metric::GPU_GRID);
+        gridShader->use();
+        glEnable(GL_BLEND);
+        glBindVertexArray(VAO);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glDisable(GL_BLEND);
+    }
 }
 
-// --- DESENHAR QUADRADO ---
-// Desenha um único quadrado na posição e cor especificadas.
-void Game::drawSquare(const GridPosition &position, const glm::vec4 &color)
+// --- DESENHAR A COBRA ---
+// Envia para a GPU apenas as cabeças novas desde o último frame e desenha a comida e todos
+// os segmentos com uma única chamada, em vez de uma chamada (com dois uniforms e uma matriz)
+// por quadrado. O custo por frame não cresce com o tamanho da cobra.
+void Game::drawSnake(float alpha)
 {
-    // Envia a cor do quadrado para o shader.
-    glUniform4f(colorLoc, color.r, color.g, color.b, color.a);
-
-    // Cria uma matriz 'model' para posicionar o quadrado no grid.
-    // Começa com a matriz identidade.
-    glm::mat4 model = glm::mat4(1.0f);
-    // Translada o quadrado (que está centrado em 0,0) para a posição correta no grid.
-    // Adiciona 0.5f para centralizar o quadrado dentro da célula do grid.
-    model = glm::translate(model, glm::vec3((float)position.x + 0.5f,
-                                            (float)position.y + 0.5f, 0.0f));
-
-    // Envia a matriz 'model' para o shader.
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-    // Ativa o VAO do quadrado.
+    // O corpo é a cópia da thread principal, atualizada pelas fotografias da simulação.
+    const RingBuffer<GridPosition>& body = renderBody;
+    segments->sync(body);
+    segments->bind(0);
+
+    segmentShader->use();
+    // Os setters por localização só chamam o OpenGL quando o valor muda (a comida e o
+    // tamanho da cobra, por exemplo, ficam iguais na maioria dos frames).
+    segmentShader->setInt(headSlotLoc, (int)segments->getHeadSlot());
+    segmentShader->setInt(segmentCountLoc, (int)body.size());
+    GridPosition previousTail = snapshots.readBuffer().previousTail;
+    segmentShader->setVec2(previousTailLoc, glm::vec2((float)previousTail.x, (float)previousTail.y));
+    segmentShader->setFloat(alphaLoc, alpha);
+    segmentShader->setVec2(foodLoc, glm::vec2((float)renderFood.x, (float)renderFood.y));
+
+    // Uma instância para a comida (a primeira), mais uma por segmento.
     glBindVertexArray(VAO);
-    // Desenha o quadrado (que consiste em 6 vértices para 2 triângulos).
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    // Desativa o VAO.
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)(body.size() + 1));
     glBindVertexArray(0);
 }
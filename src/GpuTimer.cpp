@@ -0,0 +1,85 @@
+// Inclui o cabeçalho da classe GpuTimer.
+#include "GpuTimer.h"
+
+// --- CONSTRUTOR ---
+// Cria todas as consultas de uma vez; elas são reaproveitadas a cada volta do anel.
+GpuTimer::GpuTimer()
+    : frame(0), skipping(false), open(false)
+{
+    for (int f = 0; f < FRAME_LATENCY; ++f)
+    {
+        for (int p = 0; p < MAX_PASSES; ++p)
+        {
+            glGenQueries(1, &queries[f][p].id);
+            queries[f][p].metric = Metric::COUNT;
+        }
+        used[f] = 0;
+    }
+}
+
+// --- DESTRUTOR ---
+GpuTimer::~GpuTimer()
+{
+    for (int f = 0; f < FRAME_LATENCY; ++f)
+    {
+        for (int p = 0; p < MAX_PASSES; ++p)
+        {
+            glDeleteQueries(1, &queries[f][p].id);
+        }
+    }
+}
+
+// --- COMEÇAR UM FRAME ---
+void GpuTimer::beginFrame()
+{
+    frame = (frame + 1) % FRAME_LATENCY;
+    skipping = false;
+
+    // As consultas desta posição foram feitas FRAME_LATENCY frames atrás. A GPU termina
+    // os comandos em ordem, então se a última já tem resultado, todas têm.
+    int count = used[frame];
+    if (count == 0)
+    {
+        return;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(queries[frame][count - 1].id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+    {
+        // A GPU está mais de FRAME_LATENCY frames atrasada: não espera por ela, e as
+        // consultas continuam pendentes até um próximo frame que caia nesta posição.
+        skipping = true;
+        return;
+    }
+    for (int p = 0; p < count; ++p)
+    {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(queries[frame][p].id, GL_QUERY_RESULT, &elapsed);
+        SNAKE_RECORD_METRIC(queries[frame][p].metric, (uint64_t)elapsed);
+    }
+    used[frame] = 0;
+}
+
+// --- MEDIR UMA PASSAGEM ---
+void GpuTimer::begin(Metric pass)
+{
+    if (skipping || used[frame] == MAX_PASSES)
+    {
+        return;
+    }
+    Query& query = queries[frame][used[frame]];
+    query.metric = pass;
+    glBeginQuery(GL_TIME_ELAPSED, query.id);
+    open = true;
+}
+
+void GpuTimer::end()
+{
+    if (!open)
+    {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    ++used[frame];
+    open = false;
+}
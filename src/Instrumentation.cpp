@@ -0,0 +1,185 @@
+// Inclui o cabeçalho da instrumentação.
+#include "Instrumentation.h"
+// Inclui a formatação da tabela de métricas e o tratamento de sinais.
+#include <iomanip>
+#include <csignal>
+#include <cmath>
+
+// --- CONSTRUTOR ---
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+// --- ZERAR ---
+void LatencyHistogram::reset()
+{
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+// --- ÍNDICE DA FAIXA ---
+// Abaixo de 128 ns, o índice é o próprio valor. Acima, 'octave' é a posição do bit mais
+// alto; os 7 bits seguintes escolhem uma das 128 faixas da oitava.
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+    {
+        return (size_t)value;
+    }
+    int octave = 63;
+    while ((value >> octave) == 0)
+    {
+        --octave;
+    }
+    if (octave > MAX_OCTAVE)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    int shift = octave - SUB_BUCKET_BITS;
+    size_t sub = (size_t)(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS * (size_t)(shift + 1) + sub;
+}
+
+uint64_t LatencyHistogram::bucketHighest(size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return (uint64_t)index;
+    }
+    int shift = (int)(index / SUB_BUCKETS) - 1;
+    uint64_t top = SUB_BUCKETS + index % SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+// --- REGISTRAR ---
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+    increment(buckets[bucketIndex(nanoseconds)], 1);
+    increment(sum, nanoseconds);
+    if (nanoseconds > maximum.load(std::memory_order_relaxed))
+    {
+        maximum.store(nanoseconds, std::memory_order_relaxed);
+    }
+    // O total é publicado por último: quem lê nunca vê mais valores do que há nas faixas.
+    total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// --- MÉDIA ---
+double LatencyHistogram::mean() const
+{
+    uint64_t n = count();
+    return n > 0 ? (double)sum.load(std::memory_order_relaxed) / (double)n : 0.0;
+}
+
+// --- PERCENTIL ---
+uint64_t LatencyHistogram::percentile(double q) const
+{
+    uint64_t n = total.load(std::memory_order_acquire);
+    if (n == 0)
+    {
+        return 0;
+    }
+    // Posição (a partir de 1) do valor procurado na lista ordenada dos valores.
+    uint64_t rank = (uint64_t)std::ceil(q * (double)n);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    uint64_t highest = max();
+    // O último valor é o máximo, guardado exatamente (mesmo acima da maior oitava).
+    if (rank >= n)
+    {
+        return highest;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            uint64_t value = bucketHighest(i);
+            return value < highest ? value : highest;
+        }
+    }
+    return highest;
+}
+
+#ifdef SNAKE_INSTRUMENTATION
+
+// Um histograma por métrica, criados na primeira chamada (a criação de um 'static' local
+// é segura mesmo com várias threads).
+LatencyHistogram& metricHistogram(Metric metric)
+{
+    static LatencyHistogram histograms[(size_t)Metric::COUNT];
+    return histograms[(size_t)metric];
+}
+
+// --- IMPRIMIR AS MÉTRICAS ---
+// Uma linha por métrica, com os tempos em microssegundos.
+void printMetrics(std::ostream& out)
+{
+    static const char* const NAMES[(size_t)Metric::COUNT] = {
+        "input", "render", "swap", "events", "frame", "tick", "input_latency",
+        "gpu_clear", "gpu_snake", "gpu_grid"
+    };
+
+    out << std::left << std::setw(14) << "metrica" << std::right
+        << std::setw(10) << "n" << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)"
+        << std::setw(12) << "p99.9 (us)" << std::setw(12) << "max (us)" << std::endl;
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < (size_t)Metric::COUNT; ++i)
+    {
+        const LatencyHistogram& h = metricHistogram((Metric)i);
+        if (h.count() == 0)
+        {
+            continue;
+        }
+        out << std::left << std::setw(14) << NAMES[i] << std::right
+            << std::setw(10) << h.count()
+            << std::setw(12) << h.percentile(0.50) / 1000.0
+            << std::setw(12) << h.percentile(0.99) / 1000.0
+            << std::setw(12) << h.percentile(0.999) / 1000.0
+            << std::setw(12) << h.max() / 1000.0 << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// --- SINAL ---
+// O tratador de um sinal só pode fazer muito pouco com segurança; marcar uma variável
+// 'volatile sig_atomic_t' é uma dessas coisas.
+static volatile std::sig_atomic_t metricsRequested = 0;
+
+#ifdef SIGUSR1
+static void onMetricsSignal(int)
+{
+    metricsRequested = 1;
+}
+#endif
+
+void installMetricsSignal()
+{
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, onMetricsSignal);
+#endif
+}
+
+bool takeMetricsRequest()
+{
+    if (metricsRequested == 0)
+    {
+        return false;
+    }
+    metricsRequested = 0;
+    return true;
+}
+
+#endif
@@ -0,0 +1,775 @@
+// Ferramenta de linha de comando que mede, uma a uma, as operações básicas da cobra:
+// 'Snake::move' (com e sem crescimento), 'isSelfCollision', 'isOutOfBounds' e
+// 'generateNewFood', com cobras de 1 a 1.000.000 de segmentos. Cada medição é repetida
+// várias vezes e o resultado é a mediana do tempo por operação, em nanossegundos.
+// Os resultados podem ser gravados em CSV ou JSON e comparados com uma gravação anterior
+// (--baseline): quem ficou mais lento que o limite (--threshold), por uma diferença maior que
+// o ruído entre as repetições e que se repete ao medir de novo, é marcado como regressão
+// (veja 'isRegression' e 'measureCase').
+// Compilado com SNAKE_MICROBENCH_GL (executável SnakeMicroBenchGL), também mede o custo de
+// enviar os quadrados de 'drawSquare' ao OpenGL, em uma janela invisível.
+// Uso: ./SnakeMicroBench [--reps N] [--max-length N] [--filter texto]
+//                        [--csv arquivo] [--json arquivo] [--baseline arquivo] [--threshold fração]
+// Ex:  ./SnakeMicroBench --json base.json
+//      ./SnakeMicroBench --baseline base.json --threshold 0.10
+// Sai com 0 se tudo correu bem, 1 em erro de uso ou de arquivo e 2 se houve regressão.
+#include "Simulation.h"
+// Inclui o ciclo em zigue-zague usado para montar cobras de qualquer tamanho.
+#include "SweepPath.h"
+// Inclui bibliotecas padrão para entrada/saída, arquivos, medição de tempo e estatística.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <iomanip>
+
+#ifdef SNAKE_MICROBENCH_GL
+// Inclui o OpenGL, a janela e o Shader, os mesmos usados pelo jogo.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Shader.h"
+#endif
+
+// Tamanhos de cobra medidos, em segmentos.
+static const uint64_t LENGTHS[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+// Níveis extras de preenchimento do grid para 'generateNewFood', além dos tamanhos acima.
+static const double FILLS[] = {0.5, 0.9, 0.99, 0.999};
+
+// Operações por repetição de cada caso. São poucas para 'move(true)' porque cada uma
+// aumenta a cobra, e o grid precisa de espaço para todas.
+static const size_t MOVE_OPS = 100000;
+static const size_t GROW_OPS = 10000;
+static const size_t QUERY_OPS = 1000000;
+static const size_t FOOD_OPS = 1000000;
+// Quadrados enviados por repetição em 'drawSquare' (no mínimo a cobra inteira uma vez).
+static const size_t DRAW_OPS = 100000;
+
+// Resultado de um caso: tempo por operação, em ns, nas várias repetições.
+struct BenchResult {
+    std::string name; // Nome único do caso (ex: "move(false)/len=1000").
+    uint64_t length;  // Tamanho da cobra no início do caso.
+    double fill;      // Fração do grid ocupada pela cobra.
+    size_t ops;       // Operações por repetição.
+    double median;
+    double min;
+    double mean;
+    double stddev;
+};
+
+// Destino dos resultados que não são usados, para que o compilador não elimine as chamadas.
+static volatile uint64_t sink;
+
+// --- MEDIÇÃO ---
+// Executa 'body' (que faz 'ops' operações) uma vez para aquecer os caches e depois 'reps'
+// vezes medindo. 'after' roda depois de cada repetição, fora da medição.
+template <typename Body, typename After>
+static BenchResult measure(const std::string& name, uint64_t length, double fill, size_t ops,
+                           int reps, Body body, After after)
+{
+    body();
+    after();
+
+    std::vector<double> samples;
+    samples.reserve(reps);
+    for (int r = 0; r < reps; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        after();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+    }
+
+    // A mediana é o valor comparado com a gravação anterior: uma repetição atrapalhada pelo
+    // sistema (interrupção, troca de contexto) não a desloca, ao contrário da média.
+    std::sort(samples.begin(), samples.end());
+    BenchResult result;
+    result.name = name;
+    result.length = length;
+    result.fill = fill;
+    result.ops = ops;
+    result.median = reps % 2 != 0 ? samples[reps / 2] : (samples[reps / 2 - 1] + samples[reps / 2]) / 2.0;
+    result.min = samples.front();
+    double sum = 0.0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+    result.mean = sum / reps;
+    double squares = 0.0;
+    for (double sample : samples)
+    {
+        squares += (sample - result.mean) * (sample - result.mean);
+    }
+    result.stddev = reps > 1 ? std::sqrt(squares / (reps - 1)) : 0.0;
+    return result;
+}
+
+template <typename Body>
+static BenchResult measure(const std::string& name, uint64_t length, double fill, size_t ops,
+                           int reps, Body body)
+{
+    return measure(name, length, fill, ops, reps, body, [] {});
+}
+
+// --- COBRAS DE TESTE ---
+// Converte uma ação do ciclo em direção da cobra.
+static Direction toDirection(Action action)
+{
+    switch (action)
+    {
+    case Action::UP:
+        return Direction::UP;
+    case Action::DOWN:
+        return Direction::DOWN;
+    case Action::LEFT:
+        return Direction::LEFT;
+    default:
+        return Direction::RIGHT;
+    }
+}
+
+// Um passo da cobra seguindo o ciclo, como 'step' faz com a ação do jogador.
+static void sweepMove(Snake& snake, int width, int height, bool grow)
+{
+    snake.changeDirection(toDirection(sweepAction(snake.getHead(), width, height)));
+    snake.move(grow);
+}
+
+// Deixa a cobra com 'length' segmentos, estendidos pelo ciclo a partir de (0, 0).
+// Seguindo o ciclo, ela continua andando sem nunca bater em si mesma nem sair do grid.
+static void buildSnake(Snake& snake, uint64_t length, int width, int height)
+{
+    snake.reset(0, 0, toDirection(sweepAction({0, 0}, width, height)));
+    for (uint64_t i = 1; i < length; ++i)
+    {
+        sweepMove(snake, width, height, true);
+    }
+}
+
+// Nome de um caso com o tamanho da cobra.
+static std::string caseName(const char* operation, uint64_t length)
+{
+    return std::string(operation) + "/len=" + std::to_string(length);
+}
+
+#ifdef SNAKE_MICROBENCH_GL
+// --- DESENHO DOS QUADRADOS ---
+// Os recursos do antigo desenho de um quadrado por chamada ('snakeVertex.vert'), que o jogo
+// trocou pelo desenho instanciado de 'Game::drawSnake'. Ficam aqui só para a comparação.
+struct SquareRenderer {
+    GLFWwindow* window = nullptr;
+    Shader* shader = nullptr;
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    int modelLoc = -1;
+    int colorLoc = -1;
+};
+
+// Cria uma janela invisível com um contexto OpenGL 3.3 e o shader dos quadrados avulsos.
+static bool initSquareRenderer(SquareRenderer& renderer, int gridWidth, int gridHeight)
+{
+    if (!glfwInit())
+    {
+        std::cerr << "Falha ao inicializar GLFW" << std::endl;
+        return false;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    renderer.window = glfwCreateWindow(800, 600, "SnakeMicroBench", NULL, NULL);
+    if (renderer.window == NULL)
+    {
+        std::cerr << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(renderer.window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cerr << "Falha ao inicializar GLAD" << std::endl;
+        return false;
+    }
+
+    float vertices[] = {
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+         0.5f,  0.5f, 0.0f,
+         0.5f,  0.5f, 0.0f,
+        -0.5f,  0.5f, 0.0f,
+        -0.5f, -0.5f, 0.0f
+    };
+    glGenVertexArrays(1, &renderer.VAO);
+    glGenBuffers(1, &renderer.VBO);
+    glBindVertexArray(renderer.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    renderer.shader = new Shader("snakeVertex.vert", "snakeColor.frag");
+    if (!renderer.shader->isLinked())
+    {
+        return false;
+    }
+    renderer.shader->use();
+    renderer.modelLoc = renderer.shader->getUniformLocation("model");
+    renderer.colorLoc = renderer.shader->getUniformLocation("objectColor");
+    renderer.shader->setMat4("projection", glm::ortho(0.0f, (float)gridWidth, 0.0f, (float)gridHeight, -1.0f, 1.0f));
+    return true;
+}
+
+static void destroySquareRenderer(SquareRenderer& renderer)
+{
+    delete renderer.shader;
+    if (renderer.VAO != 0)
+    {
+        glDeleteVertexArrays(1, &renderer.VAO);
+        glDeleteBuffers(1, &renderer.VBO);
+    }
+    if (renderer.window != nullptr)
+    {
+        glfwDestroyWindow(renderer.window);
+    }
+    glfwTerminate();
+}
+
+// Um quadrado como o jogo desenhava antes: cor, matriz 'model' e uma chamada de desenho.
+static void drawSquare(SquareRenderer& renderer, const GridPosition& position, const glm::vec4& color)
+{
+    renderer.shader->setVec4(renderer.colorLoc, color);
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position.x + 0.5f, position.y + 0.5f, 0.0f));
+    renderer.shader->setMat4(renderer.modelLoc, model);
+    glBindVertexArray(renderer.VAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+}
+#endif
+
+// --- GRAVAÇÃO DOS RESULTADOS ---
+// O lado do grid é gravado junto: ele depende de --reps e --max-length, e os casos 'fill='
+// (e o uso de cache de todos) mudam com ele, então gravações com lados diferentes não se comparam.
+static bool writeCsv(const std::string& path, const std::vector<BenchResult>& results, int side)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);
+    file << "name,side,length,fill,ops,median_ns,min_ns,mean_ns,stddev_ns\n";
+    for (const BenchResult& result : results)
+    {
+        file << result.name << ',' << side << ',' << result.length << ',' << std::setprecision(6) << result.fill
+             << std::setprecision(3) << ',' << result.ops << ',' << result.median << ',' << result.min
+             << ',' << result.mean << ',' << result.stddev << '\n';
+    }
+    return file.good();
+}
+
+static bool writeJson(const std::string& path, const std::vector<BenchResult>& results, int reps, int side)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"reps\": " << reps << ",\n  \"side\": " << side << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& result = results[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "    {\"name\": \"" << result.name << "\", \"length\": " << result.length
+             << ", \"fill\": " << std::setprecision(6) << result.fill << std::setprecision(3)
+             << ", \"ops\": " << result.ops << ", \"median_ns\": " << result.median
+             << ", \"min_ns\": " << result.min << ", \"mean_ns\": " << result.mean
+             << ", \"stddev_ns\": " << result.stddev << "}";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+// --- LEITURA DA GRAVAÇÃO ANTERIOR ---
+// O que a comparação usa de cada caso gravado.
+struct BaselineEntry {
+    double median;
+    double min;
+    double stddev;
+};
+
+// Lê o número que segue 'key' em 'text', procurando de 'from' até 'to'. Retorna falso se
+// a chave não está nesse trecho.
+static bool findNumber(const std::string& text, const std::string& key, size_t from, size_t to, double& value)
+{
+    size_t position = text.find(key, from);
+    if (position == std::string::npos || position >= to)
+    {
+        return false;
+    }
+    value = std::strtod(text.c_str() + position + key.size(), nullptr);
+    return true;
+}
+
+// Lê os casos e o lado do grid de um arquivo escrito por 'writeCsv' ou 'writeJson' (o
+// formato é reconhecido pelo primeiro caractere). Não é um leitor de JSON genérico: espera
+// os campos como esta ferramenta os escreve. 'side' fica 0 se o arquivo não o informa.
+static bool readBaseline(const std::string& path, std::map<std::string, BaselineEntry>& entries, int& side)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+    {
+        return false;
+    }
+    side = 0;
+
+    if (text[first] == '{' || text[first] == '[')
+    {
+        const std::string nameKey = "\"name\": \"";
+        double value = 0.0;
+        size_t results = text.find("\"results\"");
+        if (findNumber(text, "\"side\":", 0, results, value))
+        {
+            side = (int)value;
+        }
+        size_t position = text.find(nameKey);
+        while (position != std::string::npos)
+        {
+            size_t nameStart = position + nameKey.size();
+            size_t nameEnd = text.find('"', nameStart);
+            if (nameEnd == std::string::npos)
+            {
+                return false;
+            }
+            // Os campos de um caso ficam entre o seu nome e o nome do próximo.
+            size_t next = text.find(nameKey, nameEnd);
+            size_t end = next == std::string::npos ? text.size() : next;
+            BaselineEntry entry;
+            if (!findNumber(text, "\"median_ns\":", nameEnd, end, entry.median) ||
+                !findNumber(text, "\"min_ns\":", nameEnd, end, entry.min) ||
+                !findNumber(text, "\"stddev_ns\":", nameEnd, end, entry.stddev))
+            {
+                return false;
+            }
+            entries[text.substr(nameStart, nameEnd - nameStart)] = entry;
+            position = next;
+        }
+        return !entries.empty();
+    }
+
+    // CSV: as colunas são encontradas pelo cabeçalho.
+    std::istringstream lines(text);
+    std::string line;
+    std::map<std::string, size_t> columnIndex;
+    std::getline(lines, line);
+    {
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ','))
+        {
+            size_t index = columnIndex.size();
+            columnIndex[field] = index;
+        }
+    }
+    const char* required[] = {"name", "median_ns", "min_ns", "stddev_ns"};
+    for (const char* column : required)
+    {
+        if (columnIndex.count(column) == 0)
+        {
+            return false;
+        }
+    }
+    while (std::getline(lines, line))
+    {
+        std::vector<std::string> columns;
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ','))
+        {
+            columns.push_back(field);
+        }
+        if (columns.size() < columnIndex.size())
+        {
+            continue;
+        }
+        BaselineEntry entry;
+        entry.median = std::strtod(columns[columnIndex["median_ns"]].c_str(), nullptr);
+        entry.min = std::strtod(columns[columnIndex["min_ns"]].c_str(), nullptr);
+        entry.stddev = std::strtod(columns[columnIndex["stddev_ns"]].c_str(), nullptr);
+        entries[columns[columnIndex["name"]]] = entry;
+        if (columnIndex.count("side") != 0)
+        {
+            side = std::atoi(columns[columnIndex["side"]].c_str());
+        }
+    }
+    return !entries.empty();
+}
+
+// --- REGRESSÕES ---
+// Desvios padrão de folga antes de uma diferença de medianas deixar de ser ruído.
+static const double NOISE_SIGMAS = 3.0;
+
+// Um caso só é regressão se as duas condições valem:
+// - o mínimo (a repetição menos atrapalhada pelo sistema, a melhor estimativa do custo
+//   real) ficou mais de 'threshold' mais lento;
+// - a mediana subiu mais que NOISE_SIGMAS desvios padrão das duas gravações juntas, ou
+//   seja, a diferença não se explica pela variação entre repetições.
+// Só a razão das medianas marcava como regressão variações de 15% entre duas execuções
+// seguidas do mesmo código.
+static bool isRegression(const BenchResult& current, const BaselineEntry& previous, double threshold)
+{
+    double noise = std::sqrt(current.stddev * current.stddev + previous.stddev * previous.stddev);
+    return current.min > previous.min * (1.0 + threshold) &&
+           current.median - previous.median > NOISE_SIGMAS * noise;
+}
+
+// Quantas vezes um caso que parece ter regredido é medido de novo antes de ser marcado.
+// Em máquinas compartilhadas, um caso inteiro às vezes roda 20-40% mais lento (todas as
+// repetições juntas, então o desvio padrão não acusa); uma regressão real se repete.
+static const int CONFIRM_RUNS = 2;
+
+// Gravação anterior usada para confirmar as regressões (vazia sem --baseline).
+struct Comparison {
+    std::map<std::string, BaselineEntry> baseline;
+    double threshold;
+};
+
+// Mede um caso com 'measure' e, se ele parecer ter regredido, mede de novo até
+// CONFIRM_RUNS vezes, ficando com a medição de menor mediana.
+template <typename Body, typename After>
+static BenchResult measureCase(const Comparison& comparison, const std::string& name, uint64_t length,
+                               double fill, size_t ops, int reps, Body body, After after)
+{
+    BenchResult best = measure(name, length, fill, ops, reps, body, after);
+    auto previous = comparison.baseline.find(name);
+    if (previous == comparison.baseline.end())
+    {
+        return best;
+    }
+    for (int run = 0; run < CONFIRM_RUNS && isRegression(best, previous->second, comparison.threshold); ++run)
+    {
+        BenchResult retry = measure(name, length, fill, ops, reps, body, after);
+        if (retry.median < best.median)
+        {
+            best = retry;
+        }
+    }
+    return best;
+}
+
+template <typename Body>
+static BenchResult measureCase(const Comparison& comparison, const std::string& name, uint64_t length,
+                               double fill, size_t ops, int reps, Body body)
+{
+    return measureCase(comparison, name, length, fill, ops, reps, body, [] {});
+}
+
+int main(int argc, char* argv[])
+{
+    int reps = 15;
+    uint64_t maxLength = 1000000;
+    std::string filter;
+    std::string csvPath;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 0.10;
+
+    // --- ARGUMENTOS ---
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--reps") == 0 && hasValue)
+        {
+            reps = std::atoi(argv[++i]);
+            if (reps < 1)
+            {
+                std::cerr << "Número de repetições inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--max-length") == 0 && hasValue)
+        {
+            maxLength = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+        {
+            csvPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+        {
+            threshold = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Uso: " << argv[0]
+                      << " [--reps N] [--max-length N] [--filter texto] [--csv arquivo] [--json arquivo]"
+                         " [--baseline arquivo] [--threshold fração]" << std::endl;
+            return 1;
+        }
+    }
+
+    Comparison comparison;
+    comparison.threshold = threshold;
+    std::map<std::string, BaselineEntry>& baseline = comparison.baseline;
+    int baselineSide = 0;
+    if (!baselinePath.empty() && !readBaseline(baselinePath, baseline, baselineSide))
+    {
+        std::cerr << "ERRO::MICROBENCH::BASELINE_NAO_LIDA: " << baselinePath << std::endl;
+        return 1;
+    }
+
+    // --- GRID ---
+    // Um único grid quadrado para todos os casos, de modo que só o tamanho da cobra muda
+    // entre eles. Ele precisa caber a maior cobra mais o crescimento de 'move(true)' em
+    // todas as repetições (inclusive as de confirmação), e ter um lado par para o ciclo.
+    uint64_t largest = 1;
+    for (uint64_t length : LENGTHS)
+    {
+        if (length <= maxLength)
+        {
+            largest = length;
+        }
+    }
+    int side = (int)std::ceil(std::sqrt((double)(largest + (uint64_t)(CONFIRM_RUNS + 1) * (reps + 1) * GROW_OPS + 1)));
+    side = std::max(side + side % 2, 1024);
+    uint64_t cells = (uint64_t)side * side;
+    if (!baseline.empty() && baselineSide != side)
+    {
+        std::cerr << "ERRO::MICROBENCH::GRID_DIFERENTE: " << baselinePath << " foi gravado com o grid "
+                  << baselineSide << "x" << baselineSide << ", e esta execução usa " << side << "x" << side
+                  << " (use os mesmos --reps e --max-length)" << std::endl;
+        return 1;
+    }
+    GameState state(side, side, 1);
+    Snake& snake = state.snake;
+
+    std::vector<BenchResult> results;
+    auto selected = [&](const std::string& name) {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    };
+
+#ifdef SNAKE_MICROBENCH_GL
+    SquareRenderer renderer;
+    if (!initSquareRenderer(renderer, side, side))
+    {
+        destroySquareRenderer(renderer);
+        return 1;
+    }
+#endif
+
+    // --- CASOS POR TAMANHO DA COBRA ---
+    for (uint64_t length : LENGTHS)
+    {
+        if (length > maxLength)
+        {
+            continue;
+        }
+        std::cerr << "Cobra com " << length << " segmentos..." << std::endl;
+        buildSnake(snake, length, side, side);
+        double fill = (double)length / cells;
+
+        // Um passo sem crescer: o rabo sai e a cabeça entra. Inclui a escolha da direção
+        // pelo ciclo, que custa o mesmo para qualquer tamanho.
+        std::string name = caseName("move(false)", length);
+        if (selected(name))
+        {
+            results.push_back(measureCase(comparison, name, length, fill, MOVE_OPS, reps, [&] {
+                for (size_t i = 0; i < MOVE_OPS; ++i)
+                {
+                    sweepMove(snake, side, side, false);
+                }
+            }));
+        }
+
+        // As consultas leem a cobra por um ponteiro 'volatile', para que o compilador não
+        // tire a chamada do laço nem a calcule uma única vez.
+        Snake* volatile target = &snake;
+        name = caseName("isSelfCollision", length);
+        if (selected(name))
+        {
+            results.push_back(measureCase(comparison, name, length, fill, QUERY_OPS, reps, [&] {
+                uint64_t hits = 0;
+                for (size_t i = 0; i < QUERY_OPS; ++i)
+                {
+                    hits += target->isSelfCollision();
+                }
+                sink = hits;
+            }));
+        }
+
+        name = caseName("isOutOfBounds", length);
+        if (selected(name))
+        {
+            results.push_back(measureCase(comparison, name, length, fill, QUERY_OPS, reps, [&] {
+                uint64_t hits = 0;
+                for (size_t i = 0; i < QUERY_OPS; ++i)
+                {
+                    hits += target->isOutOfBounds();
+                }
+                sink = hits;
+            }));
+        }
+
+        name = caseName("generateNewFood", length);
+        if (selected(name))
+        {
+            results.push_back(measureCase(comparison, name, length, fill, FOOD_OPS, reps, [&] {
+                uint64_t sum = 0;
+                for (size_t i = 0; i < FOOD_OPS; ++i)
+                {
+                    GridPosition food = generateNewFood(state);
+                    sum += (uint64_t)food.x + (uint64_t)food.y;
+                }
+                sink = sum;
+            }));
+        }
+
+#ifdef SNAKE_MICROBENCH_GL
+        // Um quadrado por segmento, como o jogo desenhava a cobra antes do desenho
+        // instanciado. Mede só o envio dos comandos: 'glFinish' (fora da medição) espera a
+        // GPU terminar antes da próxima repetição, para a fila do driver não encher.
+        name = caseName("drawSquare", length);
+        if (selected(name))
+        {
+            const RingBuffer<GridPosition>& body = snake.getBody();
+            size_t frames = std::max<size_t>(1, DRAW_OPS / length);
+            glm::vec4 color(0.0f, 1.0f, 0.0f, 1.0f);
+            results.push_back(measureCase(comparison, name, length, fill, frames * body.size(), reps, [&] {
+                for (size_t f = 0; f < frames; ++f)
+                {
+                    for (size_t i = 0; i < body.size(); ++i)
+                    {
+                        drawSquare(renderer, body[i], color);
+                    }
+                }
+            }, [] { glFinish(); }));
+        }
+#endif
+
+        // Por último, porque cada passo aumenta a cobra.
+        name = caseName("move(true)", length);
+        if (selected(name))
+        {
+            results.push_back(measureCase(comparison, name, length, fill, GROW_OPS, reps, [&] {
+                for (size_t i = 0; i < GROW_OPS; ++i)
+                {
+                    sweepMove(snake, side, side, true);
+                }
+            }));
+        }
+    }
+
+    // --- COMIDA EM GRIDS QUASE CHEIOS ---
+    // Acima de ~95% só restam as frações extras: é onde um sorteio por tentativa e erro
+    // ficaria lento, e o conjunto de células livres não deve.
+    // Estes casos não são limitados por --max-length.
+    for (double ratio : FILLS)
+    {
+        uint64_t length = std::min(cells - 1, (uint64_t)(ratio * cells));
+        std::ostringstream name;
+        name << "generateNewFood/fill=" << ratio;
+        if (!selected(name.str()))
+        {
+            continue;
+        }
+        std::cerr << "Grid " << ratio * 100.0 << "% cheio..." << std::endl;
+        buildSnake(snake, length, side, side);
+        results.push_back(measureCase(comparison, name.str(), length, (double)length / cells, FOOD_OPS, reps, [&] {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < FOOD_OPS; ++i)
+            {
+                GridPosition food = generateNewFood(state);
+                sum += (uint64_t)food.x + (uint64_t)food.y;
+            }
+            sink = sum;
+        }));
+    }
+
+#ifdef SNAKE_MICROBENCH_GL
+    destroySquareRenderer(renderer);
+#endif
+
+    // --- TABELA ---
+    std::cout << "Grid " << side << "x" << side << ", " << reps << " repetições (ns por operação)\n";
+    std::cout << std::left << std::setw(32) << "caso" << std::right << std::setw(12) << "mediana"
+              << std::setw(12) << "min" << std::setw(12) << "desvio";
+    if (!baseline.empty())
+    {
+        // "ç" e "ã" ocupam dois bytes cada, então 'setw' não alinharia "variação".
+        std::cout << std::setw(14) << "min anterior" << "  variação";
+    }
+    std::cout << "\n" << std::fixed << std::setprecision(2);
+
+    int regressions = 0;
+    for (const BenchResult& result : results)
+    {
+        std::cout << std::left << std::setw(32) << result.name << std::right << std::setw(12) << result.median
+                  << std::setw(12) << result.min << std::setw(12) << result.stddev;
+        auto previous = baseline.find(result.name);
+        if (previous != baseline.end() && previous->second.min > 0.0)
+        {
+            double change = result.min / previous->second.min - 1.0;
+            std::cout << std::setw(14) << previous->second.min << std::setw(9) << change * 100.0 << "%";
+            if (isRegression(result, previous->second, threshold))
+            {
+                std::cout << "  REGRESSÃO";
+                ++regressions;
+            }
+        }
+        std::cout << "\n";
+    }
+    std::cout.flush();
+
+    // --- ARQUIVOS ---
+    if (!csvPath.empty() && !writeCsv(csvPath, results, side))
+    {
+        std::cerr << "ERRO::MICROBENCH::ARQUIVO_NAO_ESCRITO: " << csvPath << std::endl;
+        return 1;
+    }
+    if (!jsonPath.empty() && !writeJson(jsonPath, results, reps, side))
+    {
+        std::cerr << "ERRO::MICROBENCH::ARQUIVO_NAO_ESCRITO: " << jsonPath << std::endl;
+        return 1;
+    }
+
+    if (regressions > 0)
+    {
+        std::cerr << regressions << " caso(s) mais de " << threshold * 100.0
+                  << "% mais lento(s) que " << baselinePath << ", além do ruído" << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Inclui o cabeçalho das fotografias de desenho.
+#include "RenderSnapshot.h"
+
+// --- CONSTRUTOR ---
+// A partida inicial começa no passo 0, então a primeira fotografia traz o corpo inteiro.
+SnapshotPublisher::SnapshotPublisher(TripleBuffer<RenderSnapshot>& buffer)
+    : buffer(buffer), recent(MAX_MOVES), tick(0), restartTick(0), acknowledged(NONE)
+{
+}
+
+// --- REGISTRAR UM PASSO ---
+void SnapshotPublisher::recordStep(const GameState& state, const StepResult& result, bool restarted)
+{
+    ++tick;
+    if (restarted)
+    {
+        // Os movimentos da partida anterior não servem para a nova: o leitor que ainda
+        // não viu este passo vai receber o corpo inteiro.
+        restartTick = tick;
+        return;
+    }
+    SnakeMove& move = recent[tick % MAX_MOVES];
+    move.head = state.snake.getHead();
+    move.grew = result.ateFood;
+}
+
+// --- PUBLICAR ---
+void SnapshotPublisher::publish(const GameState& state, double time)
+{
+    RenderSnapshot& snapshot = buffer.writeBuffer();
+    snapshot.tick = tick;
+    snapshot.time = time;
+    snapshot.food = state.food;
+    snapshot.hasFood = !state.snake.isBoardFull();
+    snapshot.previousTail = state.snake.getPreviousTail();
+    snapshot.length = state.snake.getBody().size();
+    snapshot.score = state.getScore();
+
+    // O leitor precisa dos movimentos dos passos depois do último que ele aplicou. Como ele
+    // só avança lendo fotografias mais novas, o valor lido aqui nunca está à frente dele.
+    uint64_t seen = acknowledged.load(std::memory_order_acquire);
+    bool full = seen == NONE || seen < restartTick || tick - seen > MAX_MOVES;
+    snapshot.full = full;
+    snapshot.body.clear();
+    snapshot.moves.clear();
+    if (full)
+    {
+        const RingBuffer<GridPosition>& body = state.snake.getBody();
+        for (const GridPosition& p : body)
+        {
+            snapshot.body.push_back(p);
+        }
+        snapshot.firstMoveTick = tick + 1;
+    }
+    else
+    {
+        snapshot.firstMoveTick = seen + 1;
+        for (uint64_t t = seen + 1; t <= tick; ++t)
+        {
+            snapshot.moves.push_back(recent[t % MAX_MOVES]);
+        }
+    }
+    buffer.publish();
+}
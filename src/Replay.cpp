@@ -0,0 +1,443 @@
+// Inclui o cabeçalho do sistema de replay.
+#include "Replay.h"
+// Inclui bibliotecas padrão para entrada/saída e manipulação de memória.
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+// Inclui as funções do sistema para mapear arquivos na memória.
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Tamanho do cabeçalho do arquivo e do cabeçalho de cada bloco, em bytes.
+static const size_t HEADER_SIZE = 24;
+static const size_t BLOCK_HEADER_SIZE = 8;
+// Número de passos acumulados em memória antes de gravar um bloco (16 KB de dados).
+static const uint32_t TICKS_PER_BLOCK = 65536;
+
+// --- FUNÇÕES AUXILIARES ---
+// Escrevem e leem inteiros em little-endian, independente da arquitetura.
+static void putU32(uint8_t* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static void putU64(uint8_t* out, uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t getU32(const uint8_t* in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= (uint32_t)in[i] << (8 * i);
+    return value;
+}
+
+static uint64_t getU64(const uint8_t* in)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+// Retorna o tamanho dos dados de um bloco, a partir do seu tipo e da sua quantidade.
+static size_t payloadSize(uint8_t type, uint32_t count)
+{
+    return type == REPLAY_BLOCK_TICKS ? (count + 3) / 4 : count;
+}
+
+// Converte uma direção gravada na ação que a reproduz.
+static Action toAction(uint8_t code)
+{
+    switch ((Direction)code)
+    {
+    case Direction::UP:
+        return Action::UP;
+    case Direction::DOWN:
+        return Action::DOWN;
+    case Direction::LEFT:
+        return Action::LEFT;
+    default:
+        return Action::RIGHT;
+    }
+}
+
+// --- GRAVADOR: CONSTRUTOR ---
+// Cria o arquivo e grava o cabeçalho.
+ReplayWriter::ReplayWriter(const char* path, int gridWidth, int gridHeight, uint64_t seed,
+                           uint32_t keyframeInterval)
+    : pendingTicks(0), totalTicks(0), keyframeInterval(keyframeInterval)
+{
+    // Re-simular custa ~0,1 µs por passo, então em grids grandes vale mais re-simular
+    // um trecho longo do que escrever o grid inteiro com frequência. Em 20x20 (1,6 KB por
+    // keyframe) o intervalo pedido é mantido; em 4096x4096 ele passa a ~67 milhões de passos.
+    uint64_t keyframeBytes = 4 * (uint64_t)gridWidth * (uint64_t)gridHeight;
+    uint64_t minimumInterval = keyframeBytes / KEYFRAME_BYTES_PER_TICK;
+    if (this->keyframeInterval != 0 && this->keyframeInterval < minimumInterval)
+        this->keyframeInterval = (uint32_t)std::min<uint64_t>(minimumInterval, UINT32_MAX);
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "ERRO::REPLAY::ARQUIVO_NAO_CRIADO: " << path << std::endl;
+        return;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    std::memcpy(header, "SNKR", 4);
+    putU32(header + 4, REPLAY_VERSION);
+    putU32(header + 8, (uint32_t)gridWidth);
+    putU32(header + 12, (uint32_t)gridHeight);
+    putU64(header + 16, seed);
+    file.write((const char*)header, HEADER_SIZE);
+
+    // Reserva o bloco inteiro de uma vez para não realocar durante o jogo.
+    packed.reserve(TICKS_PER_BLOCK / 4);
+}
+
+// --- GRAVADOR: DESTRUTOR ---
+ReplayWriter::~ReplayWriter()
+{
+    flush();
+}
+
+// --- REGISTRAR UM PASSO ---
+// Guarda os 2 bits da direção na posição livre do byte atual.
+void ReplayWriter::record(Direction direction)
+{
+    if (!file.is_open())
+        return;
+
+    uint32_t shift = (pendingTicks & 3) * 2;
+    if (shift == 0)
+        packed.push_back(0);
+    packed.back() |= (uint8_t)((uint8_t)direction << shift);
+    ++pendingTicks;
+    ++totalTicks;
+
+    if (pendingTicks == TICKS_PER_BLOCK)
+        flush();
+}
+
+// --- GRAVAR KEYFRAME ---
+// A cada 'keyframeInterval' passos, grava o estado completo da partida, para que um
+// leitor possa começar dali em vez de re-simular desde o início.
+void ReplayWriter::recordState(const GameState& state)
+{
+    if (!file.is_open() || keyframeInterval == 0 || totalTicks == 0 || totalTicks % keyframeInterval != 0)
+        return;
+
+    // Os passos anteriores ao keyframe precisam vir antes dele no arquivo.
+    flush();
+
+    const RingBuffer<GridPosition>& body = state.snake.getBody();
+    const FreeCellSet& freeCells = state.snake.getFreeCells();
+    keyframe.resize(BLOCK_HEADER_SIZE + 44 + 4 * (body.size() + freeCells.size()));
+    uint8_t* out = keyframe.data();
+
+    out[0] = REPLAY_BLOCK_KEYFRAME;
+    out[1] = out[2] = out[3] = 0;
+    putU32(out + 4, (uint32_t)(keyframe.size() - BLOCK_HEADER_SIZE));
+    out += BLOCK_HEADER_SIZE;
+
+    putU64(out, totalTicks);
+    putU32(out + 8, (uint32_t)state.snake.getCurrentDirection());
+    putU32(out + 12, (uint32_t)state.food.x);
+    putU32(out + 16, (uint32_t)state.food.y);
+    putU64(out + 20, state.rng.getState());
+    putU64(out + 28, state.rng.getIncrement());
+    putU32(out + 36, (uint32_t)body.size());
+    putU32(out + 40, (uint32_t)freeCells.size());
+    out += 44;
+    for (const auto& segment : body)
+    {
+        putU32(out, (uint32_t)(segment.y * state.gridWidth + segment.x));
+        out += 4;
+    }
+    for (size_t i = 0; i < freeCells.size(); ++i)
+    {
+        putU32(out, freeCells.indexAt(i));
+        out += 4;
+    }
+
+    file.write((const char*)keyframe.data(), (std::streamsize)keyframe.size());
+    file.flush();
+}
+
+// --- GRAVAR BLOCO ---
+// Escreve os passos pendentes como um bloco no fim do arquivo.
+void ReplayWriter::flush()
+{
+    if (!file.is_open() || pendingTicks == 0)
+        return;
+
+    uint8_t blockHeader[BLOCK_HEADER_SIZE] = {REPLAY_BLOCK_TICKS, 0, 0, 0};
+    putU32(blockHeader + 4, pendingTicks);
+    file.write((const char*)blockHeader, BLOCK_HEADER_SIZE);
+    file.write((const char*)packed.data(), (std::streamsize)packed.size());
+    file.flush();
+
+    packed.clear();
+    pendingTicks = 0;
+}
+
+// --- LEITOR: CONSTRUTOR ---
+// Mapeia o arquivo na memória, valida o cabeçalho e conta os passos.
+ReplayReader::ReplayReader(const char* path)
+    : data(nullptr), size(0), validSize(0), gridWidth(0), gridHeight(0), seed(0), tickCount(0)
+{
+#ifdef _WIN32
+    // Sem mmap POSIX: lê o arquivo inteiro para a memória.
+    FILE* f = std::fopen(path, "rb");
+    if (f == nullptr)
+    {
+        std::cerr << "ERRO::REPLAY::ARQUIVO_NAO_LIDO: " << path << std::endl;
+        return;
+    }
+    std::fseek(f, 0, SEEK_END);
+    size = (size_t)std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    uint8_t* buffer = (uint8_t*)std::malloc(size > 0 ? size : 1);
+    size = std::fread(buffer, 1, size, f);
+    std::fclose(f);
+    data = buffer;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "ERRO::REPLAY::ARQUIVO_NAO_LIDO: " << path << std::endl;
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        size = (size_t)info.st_size;
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            data = (const uint8_t*)mapped;
+            // O arquivo é lido do início ao fim, então avisa o sistema para ler adiante.
+            madvise(mapped, size, MADV_SEQUENTIAL);
+        }
+    }
+    // O mapeamento continua válido depois de fechar o descritor.
+    close(fd);
+    if (data == nullptr)
+    {
+        std::cerr << "ERRO::REPLAY::ARQUIVO_NAO_MAPEADO: " << path << std::endl;
+        return;
+    }
+#endif
+
+    // Valida o cabeçalho.
+    // A versão 1 (sem keyframes) continua sendo lida.
+    if (size < HEADER_SIZE || std::memcmp(data, "SNKR", 4) != 0 ||
+        getU32(data + 4) == 0 || getU32(data + 4) > REPLAY_VERSION)
+    {
+        std::cerr << "ERRO::REPLAY::FORMATO_INVALIDO: " << path << std::endl;
+        release();
+        return;
+    }
+    gridWidth = (int)getU32(data + 8);
+    gridHeight = (int)getU32(data + 12);
+    seed = getU64(data + 16);
+    // O jogo precisa de pelo menos 2x2 células, e as células dos keyframes são gravadas
+    // como u32, então o grid não pode passar de 2^32 células.
+    if (gridWidth < 2 || gridHeight < 2 || (uint64_t)gridWidth * (uint64_t)gridHeight > UINT32_MAX)
+    {
+        std::cerr << "ERRO::REPLAY::GRID_INVALIDO: " << path << std::endl;
+        release();
+        return;
+    }
+    const uint64_t cellCount = (uint64_t)gridWidth * (uint64_t)gridHeight;
+
+    // Percorre os cabeçalhos dos blocos para contar os passos e montar o índice de
+    // keyframes. Um bloco cortado no fim (por exemplo, se o jogo foi encerrado à força)
+    // é ignorado.
+    size_t offset = HEADER_SIZE;
+    while (offset + BLOCK_HEADER_SIZE <= size)
+    {
+        uint8_t type = data[offset];
+        uint32_t count = getU32(data + offset + 4);
+        size_t bytes = payloadSize(type, count);
+        if (offset + BLOCK_HEADER_SIZE + bytes > size)
+            break;
+        if (type == REPLAY_BLOCK_TICKS)
+        {
+            tickCount += count;
+        }
+        else if (type == REPLAY_BLOCK_KEYFRAME)
+        {
+            // A cobra tem pelo menos a cabeça, o corpo e as células livres cobrem o grid
+            // inteiro, e tudo precisa caber no bloco. Um keyframe que não confere torna o
+            // arquivo inteiro suspeito, então ele é recusado.
+            const uint8_t* in = data + offset + BLOCK_HEADER_SIZE;
+            uint64_t length = bytes >= 44 ? getU32(in + 36) : 0;
+            uint64_t freeCount = bytes >= 44 ? getU32(in + 40) : 0;
+            if (length == 0 || length + freeCount != cellCount || 44 + 4 * cellCount > bytes)
+            {
+                std::cerr << "ERRO::REPLAY::KEYFRAME_INVALIDO: " << path << std::endl;
+                release();
+                return;
+            }
+            keyframes.push_back({getU64(in), offset});
+        }
+        offset += BLOCK_HEADER_SIZE + bytes;
+    }
+    validSize = offset;
+}
+
+// --- LEITOR: DESTRUTOR ---
+ReplayReader::~ReplayReader()
+{
+    release();
+}
+
+// --- LIBERAR O ARQUIVO ---
+// Desfaz o mapeamento (ou libera a cópia em memória) e marca o leitor como fechado.
+void ReplayReader::release()
+{
+    if (data == nullptr)
+        return;
+#ifdef _WIN32
+    std::free((void*)data);
+#else
+    munmap((void*)data, size);
+#endif
+    data = nullptr;
+    size = 0;
+    validSize = 0;
+}
+
+// --- RE-SIMULAR ---
+// Aplica cada direção gravada com 'step', reiniciando a partida como o jogo faz.
+ReplayStats ReplayReader::simulate(GameState& state, uint64_t ticks) const
+{
+    ReplayStats stats = {0, 0, 0, 0};
+    if (data == nullptr)
+        return stats;
+    return simulateFrom(HEADER_SIZE, std::min(ticks, tickCount), state);
+}
+
+// Re-simula até 'ticks' passos, lendo os blocos a partir de 'offset' e pulando keyframes.
+ReplayStats ReplayReader::simulateFrom(size_t offset, uint64_t ticks, GameState& state) const
+{
+    ReplayStats stats = {0, 0, 0, 0};
+
+    while (offset < validSize && stats.ticks < ticks)
+    {
+        uint8_t type = data[offset];
+        uint32_t count = getU32(data + offset + 4);
+        const uint8_t* codes = data + offset + BLOCK_HEADER_SIZE;
+        offset += BLOCK_HEADER_SIZE + payloadSize(type, count);
+
+        if (type != REPLAY_BLOCK_TICKS)
+            continue;
+
+        for (uint32_t i = 0; i < count && stats.ticks < ticks; ++i)
+        {
+            uint8_t code = (codes[i >> 2] >> ((i & 3) * 2)) & 3;
+            StepResult result = step(state, toAction(code));
+            ++stats.ticks;
+
+            if (result.gameOver || result.won)
+            {
+                int score = state.getScore();
+                if (score > stats.bestScore)
+                    stats.bestScore = score;
+                ++stats.games;
+                if (result.won)
+                    ++stats.wins;
+                resetGame(state);
+            }
+        }
+    }
+    return stats;
+}
+
+// --- PULAR PARA UM PASSO ---
+// Restaura o keyframe mais próximo antes de 'tick' e re-simula o restante.
+bool ReplayReader::seek(uint64_t tick, GameState& state) const
+{
+    if (data == nullptr || tick > tickCount)
+        return false;
+
+    // Busca binária pelo último keyframe com passo <= 'tick'.
+    auto next = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+                                 [](uint64_t t, const KeyframeEntry& entry) { return t < entry.tick; });
+
+    if (next == keyframes.begin())
+    {
+        // Nenhum keyframe antes de 'tick': começa do início da sessão.
+        restartGame(state, seed);
+        simulateFrom(HEADER_SIZE, tick, state);
+        return true;
+    }
+
+    const KeyframeEntry& entry = *(next - 1);
+    const uint8_t* in = data + entry.offset + BLOCK_HEADER_SIZE;
+    uint32_t code = getU32(in + 8);
+    uint32_t length = getU32(in + 36);
+    uint32_t freeCount = getU32(in + 40);
+    const uint8_t* cells = in + 44;
+    // O tamanho do keyframe foi conferido ao abrir o arquivo; a direção, a comida e as
+    // células são conferidas aqui, antes de mexer em 'state'. Corpo e células livres juntos
+    // devem ser cada célula do grid exatamente uma vez, e a comida fica dentro do grid, fora
+    // do corpo. Só a cabeça pode estar sobre ela: 'step' confere a comida antes de mover, então
+    // a cobra que acabou de chegar à comida só a come no passo seguinte.
+    uint32_t cellCount = (uint32_t)gridWidth * (uint32_t)gridHeight;
+    if (code > (uint32_t)Direction::RIGHT)
+        return false;
+    uint32_t foodX = getU32(in + 12);
+    uint32_t foodY = getU32(in + 16);
+    if (foodX >= (uint32_t)gridWidth || foodY >= (uint32_t)gridHeight)
+        return false;
+    uint32_t foodCell = foodY * (uint32_t)gridWidth + foodX;
+    std::vector<bool> seen(cellCount, false);
+    for (uint32_t i = 0; i < cellCount; ++i)
+    {
+        uint32_t cell = getU32(cells + 4 * (size_t)i);
+        if (cell >= cellCount || seen[cell] || (i > 0 && i < length && cell == foodCell))
+            return false;
+        seen[cell] = true;
+    }
+    Direction direction = (Direction)code;
+    auto cellAt = [&](uint32_t i) {
+        uint32_t cell = getU32(cells + 4 * i);
+        return GridPosition{(int)(cell % (uint32_t)gridWidth), (int)(cell / (uint32_t)gridWidth)};
+    };
+
+    // Reconstrói o corpo do rabo até a cabeça: começa com o rabo e faz a cobra crescer
+    // por cada segmento, o que também refaz o mapa de ocupação e as células livres.
+    GridPosition tail = cellAt(length - 1);
+    state.snake.reset(tail.x, tail.y, direction);
+    for (uint32_t i = length - 1; i-- > 0;)
+    {
+        state.snake.advance(cellAt(i), true);
+    }
+    // Restaura a ordem das células livres, da qual depende o sorteio das próximas comidas.
+    std::vector<uint32_t> order(freeCount);
+    for (uint32_t i = 0; i < freeCount; ++i)
+    {
+        order[i] = getU32(cells + 4 * ((size_t)length + i));
+    }
+    state.snake.setFreeCellOrder(order.data(), order.size());
+    state.food = {(int)foodX, (int)foodY};
+    state.rng.setState(getU64(in + 20), getU64(in + 28));
+
+    // Re-simula a partir do bloco seguinte ao keyframe.
+    size_t offset = entry.offset + BLOCK_HEADER_SIZE + getU32(data + entry.offset + 4);
+    simulateFrom(offset, tick - entry.tick, state);
+    return true;
+}
@@ -0,0 +1,136 @@
+// Ferramenta de linha de comando que re-simula arquivos de replay sem janela,
+// na velocidade máxima da CPU, e exibe as estatísticas de cada arquivo.
+// Com --verify, também confere se 'seek' chega ao mesmo estado que a re-simulação desde o
+// início, em vários passos e sempre reaproveitando a mesma partida (como um visualizador faria).
+// Uso: ./SnakeReplay [--verify] partida1.replay [partida2.replay ...]
+#include "Replay.h"
+// Inclui bibliotecas padrão para entrada/saída, medição de tempo e ordenação.
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+// Verdadeiro se as duas partidas estão no mesmo estado: cobra, comida, gerador e a ordem
+// das células livres (da qual dependem as próximas comidas).
+static bool sameState(const GameState& a, const GameState& b)
+{
+    const RingBuffer<GridPosition>& bodyA = a.snake.getBody();
+    const RingBuffer<GridPosition>& bodyB = b.snake.getBody();
+    if (bodyA.size() != bodyB.size() || !(a.food == b.food) ||
+        a.snake.getCurrentDirection() != b.snake.getCurrentDirection() ||
+        a.rng.getState() != b.rng.getState() || a.rng.getIncrement() != b.rng.getIncrement() ||
+        a.snake.getFreeCellCount() != b.snake.getFreeCellCount())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < bodyA.size(); ++i)
+    {
+        if (!(bodyA[i] == bodyB[i]))
+        {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a.snake.getFreeCellCount(); ++i)
+    {
+        if (a.snake.getFreeCells().indexAt(i) != b.snake.getFreeCells().indexAt(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- VERIFICAÇÃO DE 'seek' ---
+// Pula para o início, o fim, cada keyframe e seus vizinhos e alguns passos sorteados, em
+// ordem embaralhada (para frente e para trás), sempre com a mesma partida 'reused', e
+// compara cada resultado com uma partida nova re-simulada desde o início.
+// Retorna o número de passos em que os estados diferiram.
+static int verifySeek(const ReplayReader& reader, GameState& reused)
+{
+    uint64_t ticks = reader.getTickCount();
+    std::vector<uint64_t> targets = {0, 1, ticks / 2, ticks};
+    for (size_t i = 0; i < reader.getKeyframeCount(); ++i)
+    {
+        uint64_t tick = reader.getKeyframeTick(i);
+        targets.push_back(tick - 1);
+        targets.push_back(tick);
+        targets.push_back(tick + 1);
+    }
+    Random random(reader.getSeed(), 2);
+    for (int i = 0; i < 16; ++i)
+    {
+        targets.push_back(ticks > 0 ? ((uint64_t)random.next() << 32 | random.next()) % ticks : 0);
+    }
+    targets.erase(std::remove_if(targets.begin(), targets.end(), [&](uint64_t t) { return t > ticks; }),
+                  targets.end());
+    for (size_t i = targets.size(); i > 1; --i)
+    {
+        std::swap(targets[i - 1], targets[random.nextBounded((uint32_t)i)]);
+    }
+
+    int mismatches = 0;
+    for (uint64_t tick : targets)
+    {
+        GameState fresh(reader.getGridWidth(), reader.getGridHeight(), reader.getSeed());
+        reader.simulate(fresh, tick);
+        if (!reader.seek(tick, reused) || !sameState(reused, fresh))
+        {
+            std::cerr << "ERRO::REPLAY::SEEK_DIVERGENTE: passo " << tick << std::endl;
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[])
+{
+    bool verify = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+    int first = verify ? 2 : 1;
+    if (argc <= first)
+    {
+        std::cerr << "Uso: " << argv[0] << " [--verify] <arquivo.replay> [...]" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = first; i < argc; ++i)
+    {
+        ReplayReader reader(argv[i]);
+        if (!reader.isOpen())
+        {
+            ++failures;
+            continue;
+        }
+
+        // Cria a partida com os mesmos parâmetros da gravação e re-simula tudo.
+        GameState state(reader.getGridWidth(), reader.getGridHeight(), reader.getSeed());
+        auto start = std::chrono::steady_clock::now();
+        ReplayStats stats = reader.simulate(state);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << argv[i] << ": "
+                  << reader.getGridWidth() << "x" << reader.getGridHeight()
+                  << ", semente " << reader.getSeed()
+                  << ", " << stats.ticks << " passos"
+                  << ", " << stats.games << " partidas (" << stats.wins << " vitórias)"
+                  << ", melhor pontuação " << stats.bestScore
+                  << ", pontuação atual " << state.getScore()
+                  << ", " << (seconds > 0.0 ? stats.ticks / seconds : 0.0) << " passos/s"
+                  << std::endl;
+
+        // A partida já usada pela re-simulação é justamente o caso que precisa ser conferido.
+        if (verify)
+        {
+            int mismatches = verifySeek(reader, state);
+            std::cout << argv[i] << ": 'seek' " << (mismatches == 0 ? "confere" : "DIVERGE")
+                      << " com a re-simulação (" << reader.getKeyframeCount() << " keyframes)" << std::endl;
+            if (mismatches > 0)
+            {
+                ++failures;
+            }
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// Inclui o cabeçalho da classe SegmentBuffer.
+#include "SegmentBuffer.h"
+
+// --- CONSTRUTOR ---
+// Cria o buffer com espaço para o anel inteiro e a textura de buffer que o expõe ao shader.
+SegmentBuffer::SegmentBuffer(size_t capacity)
+    : buffer(0), texture(0), capacity(capacity), headSlot(0), valid(false), lastUploadCount(0)
+{
+    // Cada posição guarda a célula (x, y) como dois inteiros de 32 bits. O buffer é
+    // alocado uma única vez com o tamanho máximo da cobra e nunca é realocado.
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, capacity * 2 * sizeof(int32_t), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // A textura de buffer permite ao shader ler qualquer posição com 'texelFetch',
+    // o que os atributos por instância não permitem (eles não dão a volta no anel).
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32I, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+// --- DESTRUTOR ---
+SegmentBuffer::~SegmentBuffer()
+{
+    glDeleteTextures(1, &texture);
+    glDeleteBuffers(1, &buffer);
+}
+
+// --- INVALIDAR ---
+void SegmentBuffer::invalidate()
+{
+    valid = false;
+}
+
+// --- SINCRONIZAR ---
+// Descobre quantas cabeças novas entraram no anel desde a última chamada e envia só elas.
+void SegmentBuffer::sync(const RingBuffer<GridPosition>& body)
+{
+    lastUploadCount = 0;
+    if (body.empty())
+    {
+        return;
+    }
+
+    size_t newHeadSlot = body.slot(0);
+    if (valid)
+    {
+        // 'push_front' recua a cabeça uma posição física, então a distância entre a cabeça
+        // antiga e a atual é o número de passos dados desde a última sincronização.
+        size_t newHeads = (headSlot + capacity - newHeadSlot) % capacity;
+        if (newHeads <= body.size())
+        {
+            upload(body, 0, newHeads);
+            headSlot = newHeadSlot;
+            return;
+        }
+    }
+
+    // Primeira sincronização, reinício da partida ou salto maior que a cobra: envia tudo.
+    upload(body, 0, body.size());
+    headSlot = newHeadSlot;
+    valid = true;
+}
+
+// --- ASSOCIAR ---
+void SegmentBuffer::bind(unsigned int unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+}
+
+// --- ENVIAR ---
+// Copia os segmentos para 'staging' e envia cada trecho contíguo com um 'glBufferSubData'.
+void SegmentBuffer::upload(const RingBuffer<GridPosition>& body, size_t first, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    while (count > 0)
+    {
+        // Trecho que vai da posição física de 'first' até a volta do anel (ou até o fim).
+        size_t slot = body.slot(first);
+        size_t run = capacity - slot;
+        if (run > count)
+        {
+            run = count;
+        }
+
+        staging.resize(run * 2);
+        for (size_t i = 0; i < run; ++i)
+        {
+            const GridPosition& p = body[first + i];
+            staging[i * 2] = p.x;
+            staging[i * 2 + 1] = p.y;
+        }
+        glBufferSubData(GL_TEXTURE_BUFFER, slot * 2 * sizeof(int32_t), run * 2 * sizeof(int32_t), staging.data());
+
+        first += run;
+        count -= run;
+        lastUploadCount += run;
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
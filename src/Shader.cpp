@@ -1,52 +1,228 @@
 // Inclui o cabeçalho da classe Shader.
 #include "Shader.h" 
-// Inclui bibliotecas para entrada/saída, manipulação de arquivos e streams de string.
+// Inclui a origem do código dos shaders (embutido no executável).
+#include "ShaderSources.h"
+// Inclui as marcações do trace (a compilação e o link aparecem como uma fase).
+#include "Tracing.h"
+// Inclui bibliotecas para entrada/saída e manipulação de arquivos.
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+// Inclui 'glm::value_ptr', que dá acesso aos floats de vetores e matrizes da GLM.
+#include <glm/gtc/type_ptr.hpp>
+
+// --- CACHE DE PROGRAMAS (GL_ARB_get_program_binary) ---
+// 'glGetProgramBinary' e 'glProgramBinary' são do OpenGL 4.1 (ou da extensão
+// GL_ARB_get_program_binary) e não fazem parte do GLAD gerado para o 3.3, então os
+// ponteiros são carregados à parte em 'enableBinaryCache'.
+typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+const GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+const GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+const GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+static GetProgramBinaryProc getProgramBinary = nullptr;
+static ProgramBinaryProc programBinary = nullptr;
+static ProgramParameteriProc programParameteri = nullptr;
+static std::string binaryCacheDirectory; // Vazio enquanto o cache estiver desligado.
+
+// Cabeçalho de cada arquivo do cache, seguido de 'length' bytes do binário do programa.
+struct ProgramBinaryHeader {
+    char magic[4];          // "SNKP"
+    uint32_t binaryFormat;  // Formato devolvido por 'glGetProgramBinary'.
+    uint32_t length;        // Tamanho do binário em bytes.
+    uint32_t reserved;
+    uint64_t key;           // Chave completa (o nome do arquivo pode colidir, a chave não).
+};
+
+// FNV-1a de 64 bits, acumulado sobre 'hash'.
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Chave de um programa: o código-fonte dos dois shaders e a identificação do driver.
+// Um binário só vale para o mesmo driver na mesma GPU, então trocar de driver, de
+// versão ou de placa gera outra chave (e o cache antigo é simplesmente ignorado).
+static uint64_t programKey(const std::string& vertexCode, const std::string& fragmentCode) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = fnv1a(hash, vertexCode.c_str(), vertexCode.size() + 1);
+    hash = fnv1a(hash, fragmentCode.c_str(), fragmentCode.size() + 1);
+    const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (GLenum name : names) {
+        const char* value = (const char*)glGetString(name);
+        if (value != nullptr) {
+            hash = fnv1a(hash, value, std::strlen(value) + 1);
+        }
+    }
+    return hash;
+}
+
+// Caminho do arquivo de cache de uma chave.
+static std::string cachePath(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return binaryCacheDirectory + "/" + name;
+}
+
+bool Shader::enableBinaryCache(const std::string& directory, GLADloadproc loader) {
+    binaryCacheDirectory.clear();
+    getProgramBinary = (GetProgramBinaryProc)loader("glGetProgramBinary");
+    programBinary = (ProgramBinaryProc)loader("glProgramBinary");
+    programParameteri = (ProgramParameteriProc)loader("glProgramParameteri");
+    if (getProgramBinary == nullptr || programBinary == nullptr || programParameteri == nullptr) {
+        return false;
+    }
+
+    // Um ponteiro não nulo não garante suporte; o driver precisa anunciar ao menos um
+    // formato de binário. Sem a extensão, a consulta gera GL_INVALID_ENUM e 'formats' fica 0.
+    GLint formats = 0;
+    glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+    while (glGetError() != GL_NO_ERROR) {}
+    if (formats <= 0) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cout << "ERRO::SHADER::CACHE_INDISPONIVEL\n" << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+    binaryCacheDirectory = directory;
+    return true;
+}
+
+// Tenta criar o programa a partir do binário em cache. Retorna falso se não houver
+// arquivo, se ele estiver corrompido ou se o driver o recusar (ex: após uma atualização).
+bool Shader::loadProgramBinary(uint64_t key) {
+    std::string path = cachePath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    ProgramBinaryHeader header;
+    if (!file.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, "SNKP", 4) != 0 ||
+        header.key != key) {
+        return false;
+    }
+    // O tamanho do binário vem do próprio arquivo: só é aceito se bater com o que sobra
+    // depois do cabeçalho (um valor corrompido faria alocar até 4 GiB).
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || header.length == 0 || fileSize != sizeof(header) + (uintmax_t)header.length) {
+        return false;
+    }
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size())) {
+        return false;
+    }
+
+    ID = glCreateProgram();
+    programBinary(ID, header.binaryFormat, binary.data(), (GLsizei)binary.size());
+    int success = 0;
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(ID);
+        ID = 0;
+        return false;
+    }
+    return true;
+}
+
+// Grava o binário do programa recém-linkado no cache. Falhas são ignoradas: o cache
+// é só uma otimização. O arquivo é escrito com outro nome e renomeado no fim, para que
+// outro processo nunca leia um arquivo pela metade.
+void Shader::saveProgramBinary(uint64_t key) {
+    GLint length = 0;
+    glGetProgramiv(ID, PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    getProgramBinary(ID, length, &length, &format, binary.data());
+
+    ProgramBinaryHeader header;
+    std::memcpy(header.magic, "SNKP", 4);
+    header.binaryFormat = format;
+    header.length = (uint32_t)length;
+    header.reserved = 0;
+    header.key = key;
+
+    std::string path = cachePath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) {
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+}
+
+// --- CONSTRUTORES ---
+// Busca o código, compila e "linka" (conecta) os shaders para criar um programa de shader.
+Shader::Shader(const char* vertexName, const char* fragmentName)
+    : ID(0), vertexName(vertexName), fragmentName(fragmentName), linked(false) {
+    // 1. --- CÓDIGO-FONTE ---
+    // O código vem da cópia embutida no executável (ou de SNAKE_SHADER_DIR, em desenvolvimento).
+    if (!loadShaderSource(vertexName, vertexCode) || !loadShaderSource(fragmentName, fragmentCode)) {
+        // Se o shader não existir, exibe uma mensagem de erro.
+        std::cout << "ERRO::SHADER::FONTE_NAO_ENCONTRADA\n" 
+                  << "Verifique o nome: " << vertexName << " ou " << fragmentName << std::endl;
+    }
+    build();
+}
+
+// Compila o código já lido (usado na recarga dos shaders durante o jogo).
+Shader::Shader(const char* vertexName, const char* fragmentName,
+               const std::string& vertexCode, const std::string& fragmentCode)
+    : ID(0), vertexName(vertexName), fragmentName(fragmentName),
+      vertexCode(vertexCode), fragmentCode(fragmentCode), linked(false) {
+    build();
+}
+
+// --- DESTRUTOR ---
+// Libera o programa na GPU (precisa do contexto OpenGL ainda ativo).
+Shader::~Shader() {
+    glDeleteProgram(ID);
+}
+
+// --- CONSTRUÇÃO DO PROGRAMA ---
+// Cria o programa a partir de 'vertexCode' e 'fragmentCode'.
+void Shader::build() {
+    SNAKE_TRACE_SCOPE("Shader::build");
+
+    // 2. --- CACHE DE PROGRAMAS ---
+    // Com o cache ligado, um programa já compilado antes por este driver é carregado
+    // direto do disco, sem compilar GLSL.
+    uint64_t key = 0;
+    if (!binaryCacheDirectory.empty()) {
+        key = programKey(vertexCode, fragmentCode);
+        if (loadProgramBinary(key)) {
+            linked = true;
+            cacheUniforms();
+            return;
+        }
+    }
 
-// --- CONSTRUTOR ---
-// Lê, compila e "linka" (conecta) os shaders para criar um programa de shader.
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
-    // 1. --- LEITURA DOS ARQUIVOS ---
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-
-    // Garante que os objetos ifstream possam lançar exceções em caso de falha.
-    vShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-    
-    try {
-        // Abre os arquivos de shader.
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        
-        // Lê o conteúdo dos arquivos para os stringstreams.
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();		
-        
-        // Fecha os manipuladores de arquivo.
-        vShaderFile.close();
-        fShaderFile.close();
-        
-        // Converte os stringstreams para strings.
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();		
-    } catch (std::ifstream::failure e) {
-        // Se a leitura falhar, exibe uma mensagem de erro.
-        std::cout << "ERRO::SHADER::ARQUIVO_NAO_LIDO\n" 
-                  << "Verifique o caminho: " << vertexPath << " ou " << fragmentPath << std::endl;
-    }
-    
     // Converte o código dos shaders de std::string para um array de caracteres C-style.
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    // 2. --- COMPILAÇÃO DOS SHADERS ---
+    // 3. --- COMPILAÇÃO DOS SHADERS ---
     unsigned int vertex, fragment;
 
     // --- Vertex Shader ---
@@ -57,25 +233,35 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     // Compila o shader.
     glCompileShader(vertex);
     // Verifica se houve erros de compilação.
-    checkCompileErrors(vertex, "VERTEX"); 
+    bool compiled = checkCompileErrors(vertex, "VERTEX"); 
 
     // --- Fragment Shader ---
     // O processo é o mesmo para o fragment shader.
     fragment = glCreateShader(GL_FRAGMENT_SHADER);
     glShaderSource(fragment, 1, &fShaderCode, NULL);
     glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT"); 
+    compiled = checkCompileErrors(fragment, "FRAGMENT") && compiled; 
 
-    // 3. --- CRIAÇÃO DO PROGRAMA DE SHADER ---
+    // 4. --- CRIAÇÃO DO PROGRAMA DE SHADER ---
     // Cria um programa de shader e obtém seu ID.
     ID = glCreateProgram();
+    // Avisa o driver de que o binário será lido depois (para o cache).
+    if (!binaryCacheDirectory.empty()) {
+        programParameteri(ID, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     // Anexa os shaders compilados ao programa.
     glAttachShader(ID, vertex);
     glAttachShader(ID, fragment);
     // "Linka" (conecta) os shaders para criar o programa executável na GPU.
     glLinkProgram(ID);
     // Verifica se houve erros de linkagem.
-    checkCompileErrors(ID, "PROGRAM"); 
+    linked = checkCompileErrors(ID, "PROGRAM") && compiled; 
+    // Guarda o programa no cache para as próximas execuções (somente se linkou).
+    if (linked && !binaryCacheDirectory.empty()) {
+        saveProgramBinary(key);
+    }
+    // Lê as localizações dos uniforms uma única vez, em vez de a cada 'set'.
+    cacheUniforms();
 
     // Após a linkagem, os objetos de shader individuais não são mais necessários.
     // Eles já fazem parte do programa, então podemos excluí-los para liberar recursos.
@@ -89,31 +275,135 @@ void Shader::use() {
     glUseProgram(ID);
 }
 
+// --- CACHE DE UNIFORMS ---
+// Pergunta ao OpenGL quais uniforms o programa linkado realmente usa e guarda a
+// localização de cada um. Uniforms declarados mas não usados são removidos pelo
+// compilador do shader e não aparecem na lista.
+void Shader::cacheUniforms() {
+    locations.clear();
+    values.clear();
+
+    int count = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    int maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(maxLength > 0 ? maxLength : 1);
+
+    for (int i = 0; i < count; ++i) {
+        int length = 0, size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+        std::string uniformName(name.data(), length);
+        int location = glGetUniformLocation(ID, uniformName.c_str());
+        if (location < 0) {
+            continue; // Uniforms de blocos não têm localização própria.
+        }
+        locations[uniformName] = location;
+        // Arrays aparecem como "nome[0]"; também aceita o nome sem o índice.
+        size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            locations[uniformName.substr(0, bracket)] = location;
+        }
+        if ((size_t)location >= values.size()) {
+            values.resize(location + 1, UniformValue{false, {}});
+        }
+    }
+}
+
+int Shader::getUniformLocation(const std::string &name) const {
+    auto it = locations.find(name);
+    return it != locations.end() ? it->second : -1;
+}
+
+bool Shader::changed(int location, const float* value, int count) const {
+    if (location < 0 || (size_t)location >= values.size()) {
+        return false;
+    }
+    UniformValue &cached = values[location];
+    if (cached.valid && std::memcmp(cached.data, value, count * sizeof(float)) == 0) {
+        return false; // O programa já tem este valor: nenhuma chamada ao OpenGL.
+    }
+    std::memcpy(cached.data, value, count * sizeof(float));
+    cached.valid = true;
+    return true;
+}
+
 // --- DEFINIR UNIFORMS ---
 // Funções para definir os valores de variáveis 'uniform' no shader.
+// As versões por nome só buscam a localização no cache e repassam para as versões por localização.
 
 void Shader::setBool(const std::string &name, bool value) const {
-    // Encontra a localização do uniform pelo nome e define seu valor.
     // `glUniform1i` é usado para um único inteiro (e booleanos são convertidos para 0 ou 1).
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    setInt(getUniformLocation(name), (int)value);
 }
 
 void Shader::setInt(const std::string &name, int value) const {
-    // Define um uniform do tipo inteiro.
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    setInt(getUniformLocation(name), value);
+}
+
+void Shader::setInt(int location, int value) const {
+    // O inteiro é comparado pelos seus bits, guardados no espaço de um float.
+    float bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (changed(location, &bits, 1)) {
+        glUniform1i(location, value);
+    }
 }
 
 void Shader::setFloat(const std::string &name, float value) const {
-    // Define um uniform do tipo float.
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    setFloat(getUniformLocation(name), value);
+}
+
+void Shader::setFloat(int location, float value) const {
+    if (changed(location, &value, 1)) {
+        glUniform1f(location, value);
+    }
+}
+
+void Shader::setVec2(const std::string &name, const glm::vec2 &value) const {
+    setVec2(getUniformLocation(name), value);
+}
+
+void Shader::setVec2(int location, const glm::vec2 &value) const {
+    if (changed(location, glm::value_ptr(value), 2)) {
+        glUniform2fv(location, 1, glm::value_ptr(value));
+    }
+}
+
+void Shader::setVec3(const std::string &name, const glm::vec3 &value) const {
+    setVec3(getUniformLocation(name), value);
+}
+
+void Shader::setVec3(int location, const glm::vec3 &value) const {
+    if (changed(location, glm::value_ptr(value), 3)) {
+        glUniform3fv(location, 1, glm::value_ptr(value));
+    }
+}
+
+void Shader::setVec4(const std::string &name, const glm::vec4 &value) const {
+    setVec4(getUniformLocation(name), value);
 }
 
-// Para outros tipos, como vetores e matrizes, as funções correspondentes do OpenGL seriam usadas.
-// Ex: glUniform3f para um vec3, glUniformMatrix4fv para uma mat4.
+void Shader::setVec4(int location, const glm::vec4 &value) const {
+    if (changed(location, glm::value_ptr(value), 4)) {
+        glUniform4fv(location, 1, glm::value_ptr(value));
+    }
+}
+
+void Shader::setMat4(const std::string &name, const glm::mat4 &value) const {
+    setMat4(getUniformLocation(name), value);
+}
+
+void Shader::setMat4(int location, const glm::mat4 &value) const {
+    if (changed(location, glm::value_ptr(value), 16)) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+}
 
 // --- VERIFICAR ERROS ---
 // Uma função de diagnóstico para verificar erros de compilação e linkagem.
-void Shader::checkCompileErrors(unsigned int shader, std::string type) {
+// Retorna verdadeiro se não houve erro.
+bool Shader::checkCompileErrors(unsigned int shader, std::string type) {
     int success;
     char infoLog[1024]; // Buffer para armazenar a mensagem de erro.
 
@@ -123,8 +413,8 @@ void Shader::checkCompileErrors(unsigned int shader, std::string type) {
         if (!success) {
             // Se a compilação falhou, obtém a mensagem de log de erro.
             glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            // Exibe a mensagem de erro.
-            std::cout << "ERRO::SHADER::" << type << "::FALHA_COMPILACAO\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            // Exibe a mensagem de erro, com o nome do arquivo.
+            std::cout << "ERRO::SHADER::" << type << "::" << (type == "VERTEX" ? vertexName : fragmentName) << "::FALHA_COMPILACAO\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     } else { // Se estivermos verificando o Programa de Shader (linkagem)
         // Pega o status da linkagem.
@@ -136,4 +426,5 @@ void Shader::checkCompileErrors(unsigned int shader, std::string type) {
             std::cout << "ERRO::SHADER::PROGRAMA::FALHA_LINKAGEM\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     }
+    return success != 0;
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+// Inclui o cabeçalho das fontes de shaders e o cabeçalho gerado pelo CMake.
+#include "ShaderSources.h"
+#include "EmbeddedShaders.h"
+// Inclui bibliotecas para leitura de arquivos e variáveis de ambiente.
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+std::string shaderOverrideDirectory()
+{
+    const char* directory = std::getenv("SNAKE_SHADER_DIR");
+    return directory != nullptr ? std::string(directory) : std::string();
+}
+
+bool loadShaderSource(const std::string& name, std::string& source)
+{
+    // 1. Diretório de desenvolvimento, se configurado. Um arquivo ausente ali não é um
+    //    erro: o diretório pode conter só os shaders que estão sendo editados.
+    std::string directory = shaderOverrideDirectory();
+    if (!directory.empty())
+    {
+        std::ifstream file(directory + "/" + name, std::ios::binary);
+        if (file)
+        {
+            std::stringstream stream;
+            stream << file.rdbuf();
+            source = stream.str();
+            return true;
+        }
+    }
+
+    // 2. Cópia embutida no executável. São poucos shaders, então uma busca linear basta.
+    for (size_t i = 0; i < EMBEDDED_SHADER_COUNT; ++i)
+    {
+        if (std::strcmp(EMBEDDED_SHADERS[i].name, name.c_str()) == 0)
+        {
+            source = EMBEDDED_SHADERS[i].source;
+            return true;
+        }
+    }
+    return false;
+}
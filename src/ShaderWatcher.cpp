@@ -0,0 +1,161 @@
+// Inclui o cabeçalho da classe ShaderWatcher.
+#include "ShaderWatcher.h"
+// Inclui bibliotecas para entrada/saída e leitura de arquivos.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+// Inclui as chamadas de sistema do Linux usadas para observar o diretório.
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+ShaderWatcher::ShaderWatcher()
+    : inotifyFd(-1), changed(false)
+{
+    stopPipe[0] = stopPipe[1] = -1;
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+    stop();
+}
+
+#ifdef __linux__
+
+bool ShaderWatcher::start(const std::string& watchedDirectory)
+{
+    stop();
+    directory = watchedDirectory;
+
+    inotifyFd = inotify_init1(IN_CLOEXEC);
+    if (inotifyFd < 0)
+    {
+        std::cerr << "ERRO::SHADER::INOTIFY_INDISPONIVEL" << std::endl;
+        return false;
+    }
+    // IN_CLOSE_WRITE cobre quem grava o arquivo no lugar; IN_MOVED_TO cobre os editores
+    // que gravam em um arquivo temporário e o renomeiam por cima do original.
+    if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        std::cerr << "ERRO::SHADER::DIRETORIO_NAO_OBSERVADO\n" << directory << std::endl;
+        close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+    if (pipe2(stopPipe, O_CLOEXEC) != 0)
+    {
+        close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+
+    thread = std::thread(&ShaderWatcher::run, this);
+    return true;
+}
+
+void ShaderWatcher::stop()
+{
+    if (thread.joinable())
+    {
+        // Um byte no pipe acorda o 'poll' da thread, que então termina.
+        char byte = 0;
+        ssize_t written = write(stopPipe[1], &byte, 1);
+        (void)written;
+        thread.join();
+    }
+    if (inotifyFd >= 0)
+    {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    for (int& fd : stopPipe)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void ShaderWatcher::run()
+{
+    // Os eventos do inotify têm tamanho variável (o nome do arquivo vem no fim).
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+
+    while (true)
+    {
+        if (poll(fds, 2, -1) < 0 || (fds[1].revents & POLLIN))
+        {
+            return;
+        }
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            continue;
+        }
+
+        for (char* p = buffer; p < buffer + length; )
+        {
+            const inotify_event* event = (const inotify_event*)p;
+            p += sizeof(inotify_event) + event->len;
+            if (event->len == 0)
+            {
+                continue;
+            }
+
+            // Só interessam os shaders (ignora arquivos temporários de editores).
+            std::string name = event->name;
+            bool isShader = name.size() > 5 &&
+                (name.compare(name.size() - 5, 5, ".vert") == 0 || name.compare(name.size() - 5, 5, ".frag") == 0);
+            if (!isShader)
+            {
+                continue;
+            }
+
+            // Lê o arquivo aqui, fora da thread de renderização.
+            std::ifstream file(directory + "/" + name, std::ios::binary);
+            if (!file)
+            {
+                continue;
+            }
+            std::stringstream stream;
+            stream << file.rdbuf();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            pending[name] = stream.str();
+            changed.store(true, std::memory_order_release);
+        }
+    }
+}
+
+#else
+
+bool ShaderWatcher::start(const std::string&)
+{
+    return false;
+}
+
+void ShaderWatcher::stop()
+{
+}
+
+void ShaderWatcher::run()
+{
+}
+
+#endif
+
+std::map<std::string, std::string> ShaderWatcher::takeChanges()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::string, std::string> changes;
+    changes.swap(pending);
+    changed.store(false, std::memory_order_release);
+    return changes;
+}
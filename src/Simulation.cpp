@@ -0,0 +1,104 @@
+// Inclui o cabeçalho com as regras do jogo.
+#include "Simulation.h"
+// Inclui as marcações do trace.
+#include "Tracing.h"
+// Converte uma ação em direção. Só deve ser chamada com ações diferentes de NONE.
+static Direction toDirection(Action action)
+{
+    switch (action)
+    {
+    case Action::UP:
+        return Direction::UP;
+    case Action::DOWN:
+        return Direction::DOWN;
+    case Action::LEFT:
+        return Direction::LEFT;
+    default:
+        return Direction::RIGHT;
+    }
+}
+
+// --- CONSTRUTOR DO ESTADO ---
+// Cria a cobra no primeiro quarto do grid e a comida no último quarto,
+// na mesma linha (para um grid de 20x20, a comida fica em (15, 10)).
+GameState::GameState(int gridWidth, int gridHeight, uint64_t seed)
+    : gridWidth(gridWidth), gridHeight(gridHeight),
+      snake(gridWidth / 4, gridHeight / 2, gridWidth, gridHeight),
+      food({gridWidth * 3 / 4, gridHeight / 2}),
+      rng(seed)
+{
+}
+
+// --- PASSO DA SIMULAÇÃO ---
+// Responsável pela lógica do jogo que acontece a cada passo de tempo.
+StepResult step(GameState& state, Action action)
+{
+    StepResult result = {false, false, false};
+
+    // Aplica a ação pedida. A cobra ignora pedidos de inversão de sentido.
+    if (action != Action::NONE)
+    {
+        state.snake.changeDirection(toDirection(action));
+    }
+
+    // Verifica se a cabeça da cobra está na mesma posição da comida.
+    result.ateFood = (state.snake.getHead() == state.food);
+
+    // Move a cobra. Se 'ateFood' for true, a cobra crescerá.
+    state.snake.move(result.ateFood);
+
+    // Verifica as condições de fim de jogo.
+    if (state.snake.isOutOfBounds() || state.snake.isSelfCollision())
+    {
+        result.gameOver = true;
+        return result;
+    }
+
+    // Se a cobra ocupou todas as células, não há onde colocar comida: vitória.
+    if (state.snake.isBoardFull())
+    {
+        result.won = true;
+        return result;
+    }
+
+    // Se a cobra comeu, gera uma nova comida.
+    if (result.ateFood)
+    {
+        state.food = generateNewFood(state);
+    }
+
+    return result;
+}
+
+// --- REINICIAR O JOGO ---
+// Reseta a cobra para sua posição inicial e sorteia uma nova comida.
+void resetGame(GameState& state)
+{
+    state.snake.reset(state.gridWidth / 4, state.gridHeight / 2);
+    state.food = generateNewFood(state);
+}
+
+// --- RECOMEÇAR A SESSÃO ---
+// Repete o que o construtor de GameState faz, reaproveitando a memória da cobra.
+// Usa 'restart' e não 'reset': a ordem das células livres deixada pela partida anterior
+// mudaria as comidas sorteadas.
+void restartGame(GameState& state, uint64_t seed)
+{
+    state.snake.restart(state.gridWidth / 4, state.gridHeight / 2);
+    state.food = {state.gridWidth * 3 / 4, state.gridHeight / 2};
+    state.rng.seed(seed);
+}
+
+// --- GERAR NOVA COMIDA ---
+// Sorteia uma posição para a comida que não esteja sobre a cobra.
+GridPosition generateNewFood(GameState& state)
+{
+    SNAKE_TRACE_SCOPE("generateNewFood");
+
+    // Em vez de sortear posições até acertar uma célula livre (o que fica cada vez mais
+    // lento conforme o grid enche), sorteia diretamente um índice do conjunto de células
+    // livres mantido pela cobra. O custo é O(1) independente do nível de preenchimento.
+    // 'nextBounded' devolve um índice uniforme, sem o viés de 'rand() % n'.
+    uint32_t index = state.rng.nextBounded((uint32_t)state.snake.getFreeCellCount());
+    return state.snake.getFreeCell(index);
+}
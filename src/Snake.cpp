@@ -5,10 +5,21 @@
 
 // --- CONSTRUTOR ---
 // Cria a cobra, definindo sua posição e direção iniciais.
-Snake::Snake(int startX, int startY)
+Snake::Snake(int startX, int startY, int gridWidth, int gridHeight)
+    // Reserva espaço para o maior corpo possível: uma célula do grid por segmento.
+    : body((size_t)gridWidth * (size_t)gridHeight),
+      occupancy(gridWidth, gridHeight),
+      freeCells(gridWidth, gridHeight),
+      selfCollision(false),
+      previousTail({startX, startY})
 {
-  // Adiciona a cabeça como o primeiro segmento do corpo.
-  body.push_back({startX, startY});
+  // Adiciona a cabeça como o primeiro segmento do corpo e marca sua célula como ocupada.
+  body.push_front({startX, startY});
+  if (occupancy.contains(body.front()))
+  {
+    occupancy.set(body.front());
+    freeCells.remove(body.front());
+  }
   // Define a direção inicial e a próxima direção como 'DIREITA'.
   currentDirection = Direction::RIGHT;
   nextDirection = Direction::RIGHT;
@@ -43,17 +54,99 @@ void Snake::move(bool grow)
     break;
   }
 
-  // Adiciona a nova cabeça no início do vetor 'body'.
-  // O corpo da cobra agora "se moveu" para frente.
-  body.insert(body.begin(), newHead);
+  // Desloca o corpo para a nova cabeça.
+  advance(newHead, grow);
+}
+
+// --- AVANÇAR O CORPO ---
+// Coloca a cabeça em 'newHead' e, se a cobra não cresceu, remove o rabo.
+// Não altera a direção: quem chama já calculou a nova cabeça.
+void Snake::advance(const GridPosition& newHead, bool grow)
+{
+  // Guarda onde o rabo estava, para a interpolação do desenho.
+  // Se a cobra crescer, o rabo não sai do lugar e esta continua sendo sua posição.
+  previousTail = body.back();
 
   // Se a cobra não comeu uma fruta ('grow' é falso), remove o último segmento.
   // Isso faz com que a cobra mantenha seu tamanho e dê a ilusão de movimento.
   // Se 'grow' for verdadeiro, o último segmento não é removido, e a cobra cresce.
+  // O rabo é removido antes de inserir a cabeça para que uma cobra que ocupa o grid
+  // inteiro nunca exceda a capacidade do buffer.
+  // A célula do rabo removido volta a ficar livre no mapa de ocupação
+  // e no conjunto de células livres.
   if (!grow)
   {
+    if (occupancy.contains(body.back()))
+    {
+      occupancy.reset(body.back());
+      freeCells.insert(body.back());
+    }
     body.pop_back();
   }
+
+  // Se a nova cabeça cair em uma célula já ocupada, a cobra bateu em si mesma.
+  // A verificação é feita aqui, antes de marcar a célula, e custa O(1).
+  // Uma célula livre que passa a ser ocupada sai do conjunto de células livres.
+  selfCollision = false;
+  if (occupancy.contains(newHead))
+  {
+    selfCollision = occupancy.test(newHead);
+    if (!selfCollision)
+    {
+      occupancy.set(newHead);
+      freeCells.remove(newHead);
+    }
+  }
+
+  // Adiciona a nova cabeça no início do buffer 'body'.
+  // O corpo da cobra agora "se moveu" para frente, em tempo constante.
+  body.push_front(newHead);
+}
+
+// --- REINICIAR A COBRA ---
+// Volta a cobra para uma única célula em (startX, startY), reaproveitando a memória
+// já alocada. Só as células ocupadas são liberadas, então o custo é O(tamanho da cobra).
+void Snake::reset(int startX, int startY, Direction direction)
+{
+  for (size_t i = 0; i < body.size(); ++i)
+  {
+    // Depois de uma auto-colisão a cabeça divide a célula com outro segmento;
+    // essa célula é liberada quando o outro segmento for visitado.
+    if (i == 0 && selfCollision)
+      continue;
+    if (occupancy.contains(body[i]))
+    {
+      occupancy.reset(body[i]);
+      freeCells.insert(body[i]);
+    }
+  }
+  body.clear();
+  selfCollision = false;
+  previousTail = {startX, startY};
+
+  // Recria a cabeça como o construtor faz.
+  body.push_front({startX, startY});
+  if (occupancy.contains(body.front()))
+  {
+    occupancy.set(body.front());
+    freeCells.remove(body.front());
+  }
+  currentDirection = direction;
+  nextDirection = direction;
+}
+
+// --- RECOMEÇO COMO NOVA ---
+// 'reset' devolve cada célula ao conjunto de livres na ordem em que o corpo a libera, então
+// a ordem depende da partida anterior. O construtor começa com todas as células em ordem de
+// índice e tira só a da cabeça; isto refaz exatamente esse estado.
+void Snake::restart(int startX, int startY, Direction direction)
+{
+  reset(startX, startY, direction);
+  freeCells.resetOrder();
+  if (occupancy.contains(body.front()))
+  {
+    freeCells.remove(body.front());
+  }
 }
 
 // --- MUDANÇA DE DIREÇÃO ---
@@ -62,61 +155,35 @@ void Snake::changeDirection(Direction newDirection)
 {
   // Adiciona uma lógica para impedir que a cobra se inverta sobre si mesma.
   // Por exemplo, se está indo para cima, não pode ir para baixo imediatamente.
-  if (currentDirection == Direction::UP && newDirection == Direction::DOWN)
+  if (isOpposite(currentDirection, newDirection))
     return; // Ignora a nova direção
-  if (currentDirection == Direction::DOWN && newDirection == Direction::UP)
-    return;
-  if (currentDirection == Direction::LEFT && newDirection == Direction::RIGHT)
-    return;
-  if (currentDirection == Direction::RIGHT && newDirection == Direction::LEFT)
-    return;
 
   // Se a nova direção for válida, armazena em 'nextDirection'.
   // Ela será aplicada no próximo chamado do método 'move'.
   nextDirection = newDirection;
 }
 
-// --- VERIFICAÇÃO DE LIMITES ---
-// Checa se a cabeça da cobra saiu da área do grid.
-bool Snake::isOutOfBounds(int gridWidth, int gridHeight) const
+// --- DIREÇÕES OPOSTAS ---
+// Retorna verdadeiro se 'a' e 'b' apontam em sentidos contrários.
+bool Snake::isOpposite(Direction a, Direction b)
 {
-  // Obtém uma referência constante à cabeça para evitar cópias.
-  const GridPosition& head = getHead();
-  // Retorna verdadeiro se a coordenada X ou Y da cabeça estiver fora do intervalo [0, gridWidth-1] ou [0, gridHeight-1].
-  return head.x < 0 || head.x >= gridWidth ||
-         head.y < 0 || head.y >= gridHeight;
+  return (a == Direction::UP && b == Direction::DOWN) ||
+         (a == Direction::DOWN && b == Direction::UP) ||
+         (a == Direction::LEFT && b == Direction::RIGHT) ||
+         (a == Direction::RIGHT && b == Direction::LEFT);
 }
 
-// --- VERIFICAÇÃO DE AUTO-COLISÃO ---
-// Checa se a cabeça da cobra colidiu com qualquer outra parte do seu corpo.
-bool Snake::isSelfCollision() const
+// --- VERIFICAÇÃO DE LIMITES ---
+// Checa se a cabeça da cobra saiu da área do grid.
+bool Snake::isOutOfBounds() const
 {
-  // A colisão só é possível se a cobra tiver 4 ou mais segmentos.
-  // Com 3 ou menos, a cabeça não pode alcançar o rabo em um movimento.
-  if (body.size() < 4)
-  {
-    return false;
-  }
-
-  // Obtém a posição da cabeça.
-  const GridPosition &head = getHead();
-  // Itera por todos os segmentos do corpo, *começando do segundo* (índice 1).
-  for (size_t i = 1; i < body.size(); i++)
-  {
-    // Se a posição da cabeça for igual à de qualquer outro segmento, houve colisão.
-    if (head == body[i])
-    {
-      return true;
-    }
-  }
-
-  // Se o loop terminar sem encontrar colisões, retorna falso.
-  return false;
+  // O mapa de ocupação conhece as dimensões do grid e faz o teste de limites.
+  return !occupancy.contains(getHead());
 }
 
 // --- OBTER CABEÇA ---
 // Retorna a posição do primeiro elemento do corpo, que é a cabeça.
 GridPosition Snake::getHead() const {
-  // body[0] é sempre a cabeça da cobra.
-  return body[0];
+  // body.front() (body[0]) é sempre a cabeça da cobra.
+  return body.front();
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Inclui o cabeçalho do trace.
+#include "Tracing.h"
+
+#ifdef SNAKE_TRACING
+
+// Inclui as operações atômicas, o relógio, a trava do registro e a escrita do arquivo.
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <cstddef>
+
+// Uma fase gravada: nome, início e duração em nanossegundos.
+struct TraceEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+};
+
+// Buffer de eventos de uma thread. Só a própria thread escreve nele, em blocos de
+// CHUNK_EVENTS eventos; os blocos nunca mudam de lugar, então crescer não copia nada.
+struct ThreadTrace {
+    static const size_t CHUNK_EVENTS = 4096;
+    // Limite por thread (~100 MB): depois disso, os eventos são contados e descartados.
+    static const size_t MAX_EVENTS = (size_t)1 << 22;
+
+    uint32_t id = 0;                                  // Número da thread no trace.
+    std::string name;                                 // Nome mostrado no visualizador.
+    std::vector<std::unique_ptr<TraceEvent[]>> chunks; // Blocos de eventos.
+    size_t count = 0;                                 // Eventos gravados.
+    uint64_t dropped = 0;                             // Eventos descartados pelo limite.
+};
+
+// --- ESTADO GLOBAL DO TRACE ---
+static std::atomic<bool> tracing(false);
+static std::chrono::steady_clock::time_point origin;
+static std::string outputPath;
+// Buffers de todas as threads que já gravaram algo. Ficam vivos até o fim do processo,
+// então os eventos de uma thread que já terminou ainda são escritos.
+static std::mutex registryMutex;
+static std::vector<std::unique_ptr<ThreadTrace>> threadTraces;
+// Buffer da thread atual (criado no primeiro evento ou nome da thread).
+static thread_local ThreadTrace* currentThread = nullptr;
+
+// Registra a thread atual no primeiro uso.
+static ThreadTrace& threadTrace()
+{
+    if (currentThread == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadTraces.emplace_back(new ThreadTrace());
+        currentThread = threadTraces.back().get();
+        currentThread->id = (uint32_t)threadTraces.size();
+    }
+    return *currentThread;
+}
+
+// --- LIGAR ---
+void beginTracing(const std::string& path)
+{
+    outputPath = path;
+    origin = std::chrono::steady_clock::now();
+    tracing.store(true, std::memory_order_release);
+}
+
+bool isTracing()
+{
+    return tracing.load(std::memory_order_relaxed);
+}
+
+void setTraceThreadName(const char* name)
+{
+    threadTrace().name = name;
+}
+
+uint64_t traceNow()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+// --- GRAVAR ---
+void recordTraceEvent(const char* name, uint64_t start, uint64_t duration)
+{
+    ThreadTrace& trace = threadTrace();
+    if (trace.count >= ThreadTrace::MAX_EVENTS)
+    {
+        ++trace.dropped;
+        return;
+    }
+    size_t chunk = trace.count / ThreadTrace::CHUNK_EVENTS;
+    if (chunk == trace.chunks.size())
+    {
+        trace.chunks.emplace_back(new TraceEvent[ThreadTrace::CHUNK_EVENTS]);
+    }
+    TraceEvent& event = trace.chunks[chunk][trace.count % ThreadTrace::CHUNK_EVENTS];
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    ++trace.count;
+}
+
+// Escreve uma string JSON, escapando aspas, barras e caracteres de controle.
+static void writeJsonString(std::ostream& out, const std::string& text)
+{
+    out << '"';
+    for (unsigned char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (c < 0x20)
+        {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+                << std::dec << std::setfill(' ');
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// --- ESCREVER O ARQUIVO ---
+// Cada fase vira um evento completo ("ph": "X") com início e duração em microssegundos,
+// e cada thread ganha um evento de metadados com o seu nome.
+bool finishTracing()
+{
+    if (!tracing.exchange(false))
+    {
+        return false;
+    }
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<ThreadTrace>& trace : threadTraces)
+    {
+        std::string name = trace->name.empty() ? "thread " + std::to_string(trace->id) : trace->name;
+        file << (first ? "\n" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace->id
+             << ",\"args\":{\"name\":";
+        writeJsonString(file, name);
+        file << "}}";
+        first = false;
+
+        for (size_t i = 0; i < trace->count; ++i)
+        {
+            const TraceEvent& event = trace->chunks[i / ThreadTrace::CHUNK_EVENTS][i % ThreadTrace::CHUNK_EVENTS];
+            file << ",\n{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace->id
+                 << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << "}";
+        }
+        if (trace->dropped > 0)
+        {
+            file << ",\n{\"name\":\"eventos descartados\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":"
+                 << trace->id << ",\"ts\":" << traceNow() / 1000.0
+                 << ",\"args\":{\"count\":" << trace->dropped << "}}";
+        }
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+
+#endif
@@ -1,15 +1,38 @@
 // Inclui o cabeçalho da classe Game, que contém toda a lógica principal do jogo.
 #include "Game.h"
+// Inclui bibliotecas padrão para conversão de strings, tempo e mensagens de erro.
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
 
 // A função 'main' é o ponto de entrada de qualquer programa C++.
 // A execução do programa começa aqui.
-int main()
+int main(int argc, char* argv[])
 {
+    // A semente do gerador aleatório pode ser passada como primeiro argumento
+    // (ex: './SnakeGame 42') para repetir uma partida. Sem argumento, usa a hora atual
+    // para que cada execução seja diferente.
+    uint64_t seed = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (uint64_t)time(0);
+    // O segundo argumento, opcional, é o arquivo onde a sessão será gravada
+    // (ex: './SnakeGame 42 partida.replay'). Um '-' significa "não gravar".
+    const char* replayPath = (argc > 2 && std::strcmp(argv[2], "-") != 0) ? argv[2] : nullptr;
+    // O terceiro argumento, opcional, é o tamanho do tabuleiro no formato LARGURAxALTURA
+    // (ex: './SnakeGame 42 - 1000x1000'). O padrão é 20x20.
+    int gridWidth = 20, gridHeight = 20;
+    if (argc > 3 && (std::sscanf(argv[3], "%dx%d", &gridWidth, &gridHeight) != 2 || gridWidth < 2 || gridHeight < 2))
+    {
+        std::cerr << "Tamanho de tabuleiro inválido: " << argv[3] << " (use, por exemplo, 40x30)" << std::endl;
+        return 1;
+    }
+
     // Cria uma instância (um objeto) da classe Game.
-    // O construtor de Game é chamado com as dimensões da janela (800 pixels de largura, 600 de altura).
+    // O construtor de Game é chamado com as dimensões da janela (800 pixels de largura, 600 de altura)
+    // e do tabuleiro.
     // Neste ponto, o método Game::init() é chamado de dentro do construtor,
     // configurando a janela, OpenGL, shaders e tudo o que é necessário para o jogo começar.
-    Game game(800, 600);
+    Game game(800, 600, gridWidth, gridHeight, seed, replayPath);
 
     // Chama o método 'run' do objeto 'game'.
     // Este método contém o loop principal do jogo (game loop), que continuará